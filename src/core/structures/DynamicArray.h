@@ -2,131 +2,728 @@
 #define DYNAMICARRAY_H
 
 #include <stdexcept>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <functional>
 
+// Невладеющее представление непрерывного диапазона элементов (аналог span).
+// Действительно, пока жив и не перевыделялся массив-владелец.
 template <class T>
-class DynamicArray 
+class ArrayView
 {
 private:
-    T* items;
-    int size;
+    const T* items;
+    std::int64_t size;
 
 public:
-    DynamicArray() : items(nullptr), size(0) {}
-    DynamicArray(int size) : size(size) 
+    ArrayView() : items(nullptr), size(0) {}
+    ArrayView(const T* items, std::int64_t count) : items(items), size(count) {}
+
+    const T* Data() const
     {
-        if (size < 0) throw std::invalid_argument("Размер не может быть отрицательным");
-        items = new T[size]();
+        return items;
     }
-    DynamicArray(T* items, int count) : size(count) 
+    std::int64_t GetSize() const
     {
-        if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
-        this->items = new T[size];
-        for (int i = 0; i < size; i++) 
+        return size;
+    }
+    bool IsEmpty() const
+    {
+        return size == 0;
+    }
+    const T& operator[](std::int64_t index) const
+    {
+        if (index < 0 || index >= size) throw std::out_of_range("Индекс вне диапазона");
+        return items[index];
+    }
+    // Доступ без проверки границ
+    const T& At(std::int64_t index) const
+    {
+        return items[index];
+    }
+    const T* begin() const
+    {
+        return items;
+    }
+    const T* end() const
+    {
+        return items + size;
+    }
+    ArrayView<T> Subview(std::int64_t startIndex, std::int64_t count) const
+    {
+        if (startIndex < 0 || count < 0 || startIndex + count > size) throw std::out_of_range("Неверный диапазон индексов");
+        return ArrayView<T>(items + startIndex, count);
+    }
+};
+
+template <class T> class DynamicArray;
+
+// Счётчики копирования DynamicArray в режиме копирования при записи.
+// Разделённая копия стоит O(1); глубокое копирование выполняется только
+// при первой записи в разделённый буфер.
+class CopyOnWriteStats
+{
+private:
+    template <class T> friend class DynamicArray;
+
+    static std::atomic<std::int64_t>& SharedCounter()
+    {
+        static std::atomic<std::int64_t> counter(0);
+        return counter;
+    }
+    static std::atomic<std::int64_t>& DetachedCounter()
+    {
+        static std::atomic<std::int64_t> counter(0);
+        return counter;
+    }
+
+public:
+    // Копии, выполненные разделением буфера
+    static std::int64_t GetSharedCopies()
+    {
+        return SharedCounter().load();
+    }
+    // Отложенные глубокие копии, выполненные при первой записи
+    static std::int64_t GetDetachedCopies()
+    {
+        return DetachedCounter().load();
+    }
+    // Глубокие копии, которые так и не понадобились
+    static std::int64_t GetAvoidedCopies()
+    {
+        return GetSharedCopies() - GetDetachedCopies();
+    }
+    static void Reset()
+    {
+        SharedCounter().store(0);
+        DetachedCounter().store(0);
+    }
+};
+
+template <class T>
+class DynamicArray
+{
+private:
+    T* items;
+    std::int64_t size;
+    std::int64_t capacity;
+    // Счётчик владельцев буфера; nullptr, если копирование при записи выключено.
+    // Указатель атомарен и изменяем: константный массив может включить режим
+    // при первом разделении буфера, в том числе из нескольких потоков
+    mutable std::atomic<std::atomic<std::int64_t>*> owners;
+    // Источник памяти под буфер; по умолчанию глобальные new/delete
+    std::pmr::memory_resource* resource;
+
+    // Буфер хранит сырую память: живыми объектами являются только первые size ячеек
+    static T* AllocateFrom(std::pmr::memory_resource* source, std::int64_t count)
+    {
+        if (count == 0) return nullptr;
+        if (static_cast<std::uint64_t>(count) > SIZE_MAX / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(source->allocate(sizeof(T) * static_cast<size_t>(count), alignof(T)));
+    }
+
+    T* Allocate(std::int64_t count) const
+    {
+        return AllocateFrom(resource, count);
+    }
+
+    void Deallocate(T* buffer, std::int64_t count) const
+    {
+        if (buffer != nullptr)
+        {
+            resource->deallocate(buffer, sizeof(T) * static_cast<size_t>(count), alignof(T));
+        }
+    }
+
+    static void Destroy(T* first, std::int64_t count)
+    {
+        if constexpr (!std::is_trivially_destructible<T>::value)
         {
-            this->items[i] = items[i];
+            std::destroy_n(first, count);
         }
     }
-    DynamicArray(const DynamicArray<T>& other) : size(other.size) 
+
+    static void CopyConstruct(const T* source, std::int64_t count, T* destination)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            if (count > 0) std::memcpy(destination, source, sizeof(T) * count);
+        }
+        else
+        {
+            std::uninitialized_copy_n(source, count, destination);
+        }
+    }
+
+    // Переносит count объектов в неинициализированную память destination,
+    // исходные объекты уничтожаются
+    static void Relocate(T* source, std::int64_t count, T* destination)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            if (count > 0) std::memcpy(destination, source, sizeof(T) * count);
+        }
+        else
+        {
+            std::uninitialized_move_n(source, count, destination);
+            Destroy(source, count);
+        }
+    }
+
+    // Перевыделяет буфер под newCapacity элементов, сохраняя первые size
+    void Reallocate(std::int64_t newCapacity)
+    {
+        T* newItems = Allocate(newCapacity);
+        try
+        {
+            Relocate(items, size, newItems);
+        }
+        catch (...)
+        {
+            Deallocate(newItems, newCapacity);
+            throw;
+        }
+        Deallocate(items, capacity);
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    // Геометрический рост: вставка в конец выполняется за амортизированное O(1)
+    std::int64_t GrownCapacity(std::int64_t minCapacity) const
+    {
+        std::int64_t newCapacity;
+        if (capacity < 4)
+        {
+            newCapacity = 4;
+        }
+        else
+        {
+            newCapacity = capacity * 2;
+        }
+        if (newCapacity < minCapacity)
+        {
+            newCapacity = minCapacity;
+        }
+        return newCapacity;
+    }
+
+    void Release()
+    {
+        std::atomic<std::int64_t>* counter = owners.load();
+        if (counter == nullptr || counter->fetch_sub(1) == 1)
+        {
+            Destroy(items, size);
+            Deallocate(items, capacity);
+            delete counter;
+        }
+        items = nullptr;
+        size = 0;
+        capacity = 0;
+        owners = nullptr;
+    }
+
+    // Лежит ли диапазон source внутри живых элементов массива
+    bool Overlaps(const T* source, std::int64_t count) const
+    {
+        if (size == 0 || count == 0) return false;
+        std::less<const T*> before;
+        return before(source, items + size) && before(items, source + count);
+    }
+
+    // Разделяет буфер other, если у него включено копирование при записи
+    bool TryShare(const DynamicArray<T>& other)
+    {
+        std::atomic<std::int64_t>* counter = other.owners.load();
+        if (counter == nullptr || other.resource != resource) return false;
+        counter->fetch_add(1);
+        items = other.items;
+        size = other.size;
+        capacity = other.capacity;
+        owners = counter;
+        CopyOnWriteStats::SharedCounter().fetch_add(1);
+        return true;
+    }
+
+    // Перед записью получает собственную копию разделённого буфера
+    void Detach()
     {
-        items = new T[size];
-        for (int i = 0; i < size; i++) 
+        std::atomic<std::int64_t>* counter = owners.load();
+        if (counter == nullptr || counter->load() == 1) return;
+        std::atomic<std::int64_t>* newOwners = new std::atomic<std::int64_t>(1);
+        T* newItems = nullptr;
+        try
+        {
+            newItems = Allocate(capacity);
+            CopyConstruct(items, size, newItems);
+        }
+        catch (...)
+        {
+            Deallocate(newItems, capacity);
+            delete newOwners;
+            throw;
+        }
+        if (counter->fetch_sub(1) == 1)
         {
-            items[i] = other.items[i];
+            // Остальные владельцы успели освободить буфер
+            Destroy(items, size);
+            Deallocate(items, capacity);
+            delete counter;
         }
+        items = newItems;
+        owners = newOwners;
+        CopyOnWriteStats::DetachedCounter().fetch_add(1);
+    }
+
+public:
+    DynamicArray() : items(nullptr), size(0), capacity(0), owners(nullptr), resource(std::pmr::get_default_resource()) {}
+    DynamicArray(std::int64_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : items(nullptr), size(0), capacity(0), owners(nullptr), resource(resource)
+    {
+        if (size < 0) throw std::invalid_argument("Размер не может быть отрицательным");
+        items = Allocate(size);
+        capacity = size;
+        std::uninitialized_value_construct_n(items, size);
+        this->size = size;
+    }
+    DynamicArray(const T* items, std::int64_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : items(nullptr), size(0), capacity(0), owners(nullptr), resource(resource)
+    {
+        if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
+        this->items = Allocate(count);
+        capacity = count;
+        CopyConstruct(items, count, this->items);
+        size = count;
+    }
+    // Принимает во владение буфер, выделенный через AllocateBuffer(capacity, resource),
+    // в котором первые count элементов уже сконструированы
+    DynamicArray(T* buffer, std::int64_t count, std::int64_t capacity, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : items(buffer), size(count), capacity(capacity), owners(nullptr), resource(resource)
+    {
+        if (count < 0 || capacity < count) throw std::invalid_argument("Неверный размер буфера");
+    }
+    // Копия, как и в std::pmr, использует источник памяти по умолчанию
+    DynamicArray(const DynamicArray<T>& other) : DynamicArray(other, std::pmr::get_default_resource()) {}
+    DynamicArray(const DynamicArray<T>& other, std::pmr::memory_resource* resource) : items(nullptr), size(0), capacity(0), owners(nullptr), resource(resource)
+    {
+        if (TryShare(other)) return;
+        items = Allocate(other.size);
+        capacity = other.size;
+        CopyConstruct(other.items, other.size, items);
+        size = other.size;
     }
-    DynamicArray(DynamicArray<T>&& other) noexcept : items(other.items), size(other.size) 
+    DynamicArray(DynamicArray<T>&& other) noexcept : items(other.items), size(other.size), capacity(other.capacity), owners(other.owners.load()), resource(other.resource)
     {
         other.items = nullptr;
         other.size = 0;
+        other.capacity = 0;
+        other.owners = nullptr;
     }
-    ~DynamicArray() 
+    ~DynamicArray()
     {
-        delete[] items;
+        Release();
     }
-    DynamicArray<T>& operator=(const DynamicArray<T>& other) 
+    // Присваивание, как и источник памяти, сохраняет режим копирования при
+    // записи у самого массива: буфер разделяется, только если режим включён
+    // у обоих массивов, иначе элементы копируются
+    DynamicArray<T>& operator=(const DynamicArray<T>& other)
     {
-        if (this != &other) 
+        if (this != &other)
         {
-            delete[] items;
-            size = other.size;
-            items = new T[size];
-            for (int i = 0; i < size; i++) 
+            bool copyOnWrite = IsCopyOnWrite();
+            std::atomic<std::int64_t>* otherOwners = other.owners.load();
+            if (copyOnWrite && otherOwners != nullptr && other.resource == resource)
+            {
+                if (owners.load() == otherOwners) return *this;
+                Release();
+                TryShare(other);
+                return *this;
+            }
+            std::atomic<std::int64_t>* newOwners = copyOnWrite ? new std::atomic<std::int64_t>(1) : nullptr;
+            T* newItems = nullptr;
+            try
+            {
+                newItems = Allocate(other.size);
+                CopyConstruct(other.items, other.size, newItems);
+            }
+            catch (...)
             {
-                items[i] = other.items[i];
+                Deallocate(newItems, other.size);
+                delete newOwners;
+                throw;
             }
+            Release();
+            items = newItems;
+            size = other.size;
+            capacity = other.size;
+            owners = newOwners;
         }
         return *this;
     }
-    DynamicArray<T>& operator=(DynamicArray<T>&& other)  
+    // Буфер забирается, только если источники памяти совпадают,
+    // иначе элементы переносятся в собственный буфер
+    DynamicArray<T>& operator=(DynamicArray<T>&& other)
     {
-        if (this != &other) 
+        if (this != &other && other.resource != resource)
+        {
+            if (other.IsShared())
+            {
+                *this = other;
+            }
+            else
+            {
+                DynamicArray<T> moved(0, resource);
+                moved.Reserve(other.size);
+                std::uninitialized_move_n(other.items, other.size, moved.items);
+                moved.size = other.size;
+                *this = std::move(moved);
+            }
+            other.Release();
+        }
+        else if (this != &other)
         {
-            delete[] items;
+            bool copyOnWrite = IsCopyOnWrite();
+            std::atomic<std::int64_t>* otherOwners = other.owners.load();
+            if (!copyOnWrite && otherOwners != nullptr && otherOwners->load() > 1)
+            {
+                // Разделённый буфер нельзя забрать в массив без счётчика
+                *this = other;
+                other.Release();
+                return *this;
+            }
+            std::atomic<std::int64_t>* newOwners = otherOwners;
+            if (copyOnWrite && newOwners == nullptr)
+            {
+                newOwners = new std::atomic<std::int64_t>(1);
+            }
+            else if (!copyOnWrite)
+            {
+                // Единственный владелец: счётчик больше не нужен
+                delete otherOwners;
+                newOwners = nullptr;
+            }
+            Release();
             items = other.items;
             size = other.size;
+            capacity = other.capacity;
+            owners = newOwners;
             other.items = nullptr;
             other.size = 0;
+            other.capacity = 0;
+            other.owners = nullptr;
         }
         return *this;
     }
-    T& operator[](int index) 
+    T& operator[](std::int64_t index)
     {
         if (index < 0 || index >= size) throw std::out_of_range("Индекс вне диапазона");
+        Detach();
         return items[index];
     }
-    const T& operator[](int index) const 
+    const T& operator[](std::int64_t index) const
     {
         if (index < 0 || index >= size) throw std::out_of_range("Индекс вне диапазона");
         return items[index];
     }
-    T& Get(int index) 
+    T& Get(std::int64_t index)
     {
         return operator[](index);
     }
-    const T& Get(int index) const 
+    const T& Get(std::int64_t index) const
     {
         return operator[](index);
     }
-    int GetSize() const 
+    // Доступ без проверки границ для горячих циклов
+    T& At(std::int64_t index)
+    {
+        Detach();
+        return items[index];
+    }
+    const T& At(std::int64_t index) const
+    {
+        return items[index];
+    }
+    T* Data()
+    {
+        Detach();
+        return items;
+    }
+    const T* Data() const
+    {
+        return items;
+    }
+    T* begin()
+    {
+        Detach();
+        return items;
+    }
+    T* end()
+    {
+        Detach();
+        return items + size;
+    }
+    const T* begin() const
+    {
+        return items;
+    }
+    const T* end() const
+    {
+        return items + size;
+    }
+    ArrayView<T> GetView() const
+    {
+        return ArrayView<T>(items, size);
+    }
+    std::int64_t GetSize() const
     {
         return size;
     }
-    void Set(int index, T value) 
+    std::int64_t GetCapacity() const
+    {
+        return capacity;
+    }
+    void Set(std::int64_t index, T value)
+    {
+        operator[](index) = std::move(value);
+    }
+    void Reserve(std::int64_t newCapacity)
     {
-        operator[](index) = value;
+        if (newCapacity < 0) throw std::invalid_argument("Ёмкость не может быть отрицательной");
+        if (newCapacity > capacity)
+        {
+            Detach();
+            Reallocate(newCapacity);
+        }
+    }
+    void ShrinkToFit()
+    {
+        if (capacity > size)
+        {
+            Detach();
+            Reallocate(size);
+        }
     }
-    void Resize(int newSize) 
+    void Resize(std::int64_t newSize)
     {
         if (newSize < 0) throw std::invalid_argument("Размер не может быть отрицательным");
         if (newSize == size) return;
-        T* newItems = new T[newSize]();
-        int copySize;
+        Detach();
         if (newSize < size)
         {
-            copySize = newSize;
+            Destroy(items + newSize, size - newSize);
+            size = newSize;
+            return;
         }
-        else
+        if (newSize > capacity)
+        {
+            Reallocate(newSize);
+        }
+        std::uninitialized_value_construct_n(items + size, newSize - size);
+        size = newSize;
+    }
+    void InsertAt(T item, std::int64_t index)
+    {
+        if (index < 0 || index > size) throw std::out_of_range("Индекс вне диапазона");
+        Detach();
+        if (size == capacity)
+        {
+            // Новый элемент сразу ставится на место, хвосты переносятся один раз
+            std::int64_t newCapacity = GrownCapacity(size + 1);
+            T* newItems = Allocate(newCapacity);
+            try
+            {
+                ::new (static_cast<void*>(newItems + index)) T(std::move(item));
+            }
+            catch (...)
+            {
+                Deallocate(newItems, newCapacity);
+                throw;
+            }
+            Relocate(items, index, newItems);
+            Relocate(items + index, size - index, newItems + index + 1);
+            Deallocate(items, capacity);
+            items = newItems;
+            capacity = newCapacity;
+            size++;
+            return;
+        }
+        if (index == size)
         {
-            copySize = size;
+            ::new (static_cast<void*>(items + size)) T(std::move(item));
+            size++;
+            return;
         }
-        for (int i = 0; i < copySize; i++) 
+        if constexpr (std::is_trivially_copyable<T>::value)
         {
-            newItems[i] = items[i];
+            std::memmove(items + index + 1, items + index, sizeof(T) * (size - index));
+            ::new (static_cast<void*>(items + index)) T(std::move(item));
         }
-        delete[] items;
-        items = newItems;
-        size = newSize;
+        else
+        {
+            ::new (static_cast<void*>(items + size)) T(std::move(items[size - 1]));
+            for (std::int64_t i = size - 1; i > index; i--)
+            {
+                items[i] = std::move(items[i - 1]);
+            }
+            items[index] = std::move(item);
+        }
+        size++;
+    }
+    void PushBack(T item)
+    {
+        InsertAt(std::move(item), size);
+    }
+
+    // Сырая память под capacity элементов, совместимая с конструктором,
+    // принимающим буфер во владение
+    static T* AllocateBuffer(std::int64_t capacity, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        if (capacity < 0) throw std::invalid_argument("Ёмкость не может быть отрицательной");
+        return AllocateFrom(resource, capacity);
     }
-    void InsertAt(T item, int index) 
+
+    // Вставляет count элементов из source перед index: одно выделение памяти
+    // и один сдвиг хвоста
+    void InsertRange(const T* source, std::int64_t count, std::int64_t index)
     {
         if (index < 0 || index > size) throw std::out_of_range("Индекс вне диапазона");
-        Resize(size + 1);
-        for (int i = size - 1; i > index; i--) 
+        if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
+        if (count == 0) return;
+        if (Overlaps(source, count))
+        {
+            // Источник лежит в собственном буфере и может сдвинуться
+            DynamicArray<T> copy(source, count);
+            InsertRange(copy.items, count, index);
+            return;
+        }
+        Detach();
+        if (size + count > capacity)
+        {
+            std::int64_t newCapacity = GrownCapacity(size + count);
+            T* newItems = Allocate(newCapacity);
+            try
+            {
+                CopyConstruct(source, count, newItems + index);
+            }
+            catch (...)
+            {
+                Deallocate(newItems, newCapacity);
+                throw;
+            }
+            Relocate(items, index, newItems);
+            Relocate(items + index, size - index, newItems + index + count);
+            Deallocate(items, capacity);
+            items = newItems;
+            capacity = newCapacity;
+            size += count;
+            return;
+        }
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            std::memmove(items + index + count, items + index, sizeof(T) * (size - index));
+            std::memcpy(items + index, source, sizeof(T) * count);
+        }
+        else
+        {
+            // Хвост переносится назад: в сырую память конструированием, в живые ячейки присваиванием
+            for (std::int64_t i = size - 1; i >= index; i--)
+            {
+                if (i + count >= size)
+                {
+                    ::new (static_cast<void*>(items + i + count)) T(std::move(items[i]));
+                }
+                else
+                {
+                    items[i + count] = std::move(items[i]);
+                }
+            }
+            for (std::int64_t i = 0; i < count; i++)
+            {
+                if (index + i < size)
+                {
+                    items[index + i] = source[i];
+                }
+                else
+                {
+                    ::new (static_cast<void*>(items + index + i)) T(source[i]);
+                }
+            }
+        }
+        size += count;
+    }
+    void AppendRange(const T* source, std::int64_t count)
+    {
+        InsertRange(source, count, size);
+    }
+    // Удаляет count элементов, начиная с startIndex
+    void EraseRange(std::int64_t startIndex, std::int64_t count)
+    {
+        if (startIndex < 0 || count < 0 || startIndex + count > size) throw std::out_of_range("Неверный диапазон индексов");
+        if (count == 0) return;
+        Detach();
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            std::memmove(items + startIndex, items + startIndex + count, sizeof(T) * (size - startIndex - count));
+        }
+        else
+        {
+            std::move(items + startIndex + count, items + size, items + startIndex);
+            Destroy(items + size - count, count);
+        }
+        size -= count;
+    }
+    // Заменяет содержимое копией count элементов из source
+    void AssignFrom(const T* source, std::int64_t count)
+    {
+        if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
+        if (count <= capacity && !Overlaps(source, count) && !IsShared())
+        {
+            Destroy(items, size);
+            size = 0;
+            CopyConstruct(source, count, items);
+            size = count;
+            return;
+        }
+        DynamicArray<T> fresh(source, count, resource);
+        if (IsCopyOnWrite())
         {
-            items[i] = items[i - 1];
+            fresh.EnableCopyOnWrite();
         }
-        items[index] = item;
+        *this = std::move(fresh);
+    }
+
+    // Включает копирование при записи: копии массива разделяют буфер,
+    // пока одна из них не начнёт изменяться. Ссылки и указатели, полученные
+    // через неконстантный доступ, нельзя сохранять после копирования массива.
+    // Режим не меняет содержимое и потому доступен у константного массива;
+    // при одновременном включении из нескольких потоков счётчик создаётся один
+    void EnableCopyOnWrite() const
+    {
+        if (owners.load() != nullptr) return;
+        std::atomic<std::int64_t>* counter = new std::atomic<std::int64_t>(1);
+        std::atomic<std::int64_t>* expected = nullptr;
+        if (!owners.compare_exchange_strong(expected, counter))
+        {
+            delete counter;
+        }
+    }
+    std::pmr::memory_resource* GetResource() const
+    {
+        return resource;
+    }
+    bool IsCopyOnWrite() const
+    {
+        return owners.load() != nullptr;
+    }
+    // Разделяет ли массив буфер с другими копиями
+    bool IsShared() const
+    {
+        std::atomic<std::int64_t>* counter = owners.load();
+        return counter != nullptr && counter->load() > 1;
     }
 };
 
-#endif
\ No newline at end of file
+#endif
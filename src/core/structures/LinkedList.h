@@ -2,6 +2,13 @@
 #define LINKEDLIST_H
 
 #include <stdexcept>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <memory>
+#include <type_traits>
+#include "node_pool.h"
 
 template <class T>
 class LinkedList 
@@ -11,48 +18,166 @@ private:
     {
         T data;
         Node* next;
-        Node(T value, Node* next = nullptr) : data(value), next(next) {}
+        Node(T value, Node* next = nullptr) : data(std::move(value)), next(next) {}
     };
     Node* head;
-    int length;
+    // Последний узел: добавление в конец и GetLast выполняются за O(1)
+    Node* tail;
+    std::int64_t length;
+    // Источник памяти под узлы; по умолчанию глобальные new/delete
+    std::pmr::memory_resource* resource;
+    // Собственный пул узлов, если он включён
+    std::unique_ptr<NodePool> nodePool;
+    Node* CreateNode(T value, Node* next = nullptr) 
+    {
+        void* memory = resource->allocate(sizeof(Node), alignof(Node));
+        try 
+        {
+            return ::new (memory) Node(std::move(value), next);
+        }
+        catch (...) 
+        {
+            resource->deallocate(memory, sizeof(Node), alignof(Node));
+            throw;
+        }
+    }
+    void DestroyNode(Node* node) 
+    {
+        node->~Node();
+        resource->deallocate(node, sizeof(Node), alignof(Node));
+    }
     void Clear() 
     {
+        if (nodePool) 
+        {
+            // Память всех узлов возвращается пулу одним шагом
+            if constexpr (!std::is_trivially_destructible<T>::value) 
+            {
+                for (Node* current = head; current; current = current->next) 
+                {
+                    current->data.~T();
+                }
+            }
+            nodePool->Release();
+            head = nullptr;
+            tail = nullptr;
+            length = 0;
+            return;
+        }
         while (head) 
         {
             Node* temp = head;
             head = head->next;
-            delete temp;
+            DestroyNode(temp);
         }
+        tail = nullptr;
         length = 0;
     }
+    // Отрезает цепочку после count узлов и возвращает начало остатка
+    static Node* CutAfter(Node* start, std::int64_t count) 
+    {
+        for (std::int64_t i = 1; start && i < count; i++) 
+        {
+            start = start->next;
+        }
+        if (!start) return nullptr;
+        Node* rest = start->next;
+        start->next = nullptr;
+        return rest;
+    }
     void CopyFrom(const LinkedList<T>& other) 
     {
         Node** current = &head;
         Node* otherCurrent = other.head;
         while (otherCurrent) 
         {
-            *current = new Node(otherCurrent->data);
+            *current = CreateNode(otherCurrent->data);
+            tail = *current;
             current = &((*current)->next);
             otherCurrent = otherCurrent->next;
         }
         length = other.length;
     }
 public:
-    LinkedList() : head(nullptr), length(0) {}
-    LinkedList(T* items, int count) : LinkedList() 
+    // Позиция для чтения: указатель на узел, переход к следующему за O(1)
+    class ConstCursor 
+    {
+    private:
+        friend class LinkedList<T>;
+        const Node* node;
+        explicit ConstCursor(const Node* node) : node(node) {}
+    public:
+        ConstCursor() : node(nullptr) {}
+        // Ложно, когда курсор вышел за последний элемент
+        bool IsValid() const 
+        {
+            return node != nullptr;
+        }
+        const T& Get() const 
+        {
+            if (!node) throw std::out_of_range("Курсор вне списка");
+            return node->data;
+        }
+        void Next() 
+        {
+            if (node) 
+            {
+                node = node->next;
+            }
+        }
+    };
+    // Позиция для изменения: помнит предыдущий узел, поэтому вставка после
+    // позиции и удаление в позиции выполняются за O(1). Курсоры, указывающие
+    // на узел сразу за местом вставки или удаления, становятся недействительными.
+    class Cursor 
+    {
+    private:
+        friend class LinkedList<T>;
+        Node* previous;
+        Node* node;
+        Cursor(Node* previous, Node* node) : previous(previous), node(node) {}
+    public:
+        Cursor() : previous(nullptr), node(nullptr) {}
+        bool IsValid() const 
+        {
+            return node != nullptr;
+        }
+        T& Get() const 
+        {
+            if (!node) throw std::out_of_range("Курсор вне списка");
+            return node->data;
+        }
+        void Next() 
+        {
+            if (node) 
+            {
+                previous = node;
+                node = node->next;
+            }
+        }
+    };
+
+    LinkedList(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : head(nullptr), tail(nullptr), length(0), resource(resource) {}
+    LinkedList(const T* items, std::int64_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : LinkedList(resource) 
     {
-        for (int i = 0; i < count; i++) 
+        for (std::int64_t i = 0; i < count; i++) 
         {
             Append(items[i]);
         }
     }
-    LinkedList(const LinkedList<T>& other) : LinkedList() 
+    // Копия, как и в std::pmr, использует источник памяти по умолчанию
+    LinkedList(const LinkedList<T>& other, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : LinkedList(resource) 
     {
         CopyFrom(other);
     }
-    LinkedList(LinkedList<T>&& other) noexcept : head(other.head), length(other.length) 
+    LinkedList(LinkedList<T>&& other) noexcept : head(other.head), tail(other.tail), length(other.length), resource(other.resource), nodePool(std::move(other.nodePool)) 
     {
+        if (nodePool) 
+        {
+            other.resource = nodePool->GetUpstream();
+        }
         other.head = nullptr;
+        other.tail = nullptr;
         other.length = 0;
     }
     ~LinkedList() 
@@ -68,41 +193,50 @@ public:
         }
         return *this;
     }
-    LinkedList<T>& operator=(LinkedList<T>&& other) noexcept 
+    // Узлы забираются, только если источники памяти совпадают
+    LinkedList<T>& operator=(LinkedList<T>&& other) 
     {
-        if (this != &other) 
+        if (this != &other && other.resource != resource) 
+        {
+            Clear();
+            CopyFrom(other);
+            other.Clear();
+        }
+        else if (this != &other) 
         {
             Clear();
             head = other.head;
+            tail = other.tail;
             length = other.length;
             other.head = nullptr;
+            other.tail = nullptr;
             other.length = 0;
         }
         return *this;
     }
-    T& operator[](int index) 
+    T& operator[](std::int64_t index) 
     {
         return Get(index);
     }
-    const T& operator[](int index) const 
+    const T& operator[](std::int64_t index) const 
     {
         return Get(index);
     }
-    T& Get(int index) 
+    T& Get(std::int64_t index) 
     {
         if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
         Node* current = head;
-        for (int i = 0; i < index; i++) 
+        for (std::int64_t i = 0; i < index; i++) 
         {
             current = current->next;
         }
         return current->data;
     }
-    const T& Get(int index) const 
+    const T& Get(std::int64_t index) const 
     {
         if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
         Node* current = head;
-        for (int i = 0; i < index; i++) 
+        for (std::int64_t i = 0; i < index; i++) 
         {
             current = current->next;
         }
@@ -120,30 +254,20 @@ public:
     }
     T& GetLast() 
     {
-        if (!head) throw std::runtime_error("Список пуст");
-        Node* current = head;
-        while (current->next) 
-        {
-            current = current->next;
-        }
-        return current->data;
+        if (!tail) throw std::runtime_error("Список пуст");
+        return tail->data;
     }
     const T& GetLast() const 
     {
-        if (!head) throw std::runtime_error("Список пуст");
-        Node* current = head;
-        while (current->next) 
-        {
-            current = current->next;
-        }
-        return current->data;
+        if (!tail) throw std::runtime_error("Список пуст");
+        return tail->data;
     }
-    LinkedList<T> GetSubList(int startIndex, int endIndex) const 
+    LinkedList<T> GetSubList(std::int64_t startIndex, std::int64_t endIndex) const 
     {
         if (startIndex < 0 || endIndex >= length || startIndex > endIndex) throw std::out_of_range("Invalid index range");
         LinkedList<T> sublist;
         Node* current = head;
-        for (int i = 0; i <= endIndex; i++) 
+        for (std::int64_t i = 0; i <= endIndex; i++) 
         {
             if (i >= startIndex) 
             {
@@ -153,34 +277,64 @@ public:
         }
         return sublist;
     }
-    int GetLength() const 
+    std::pmr::memory_resource* GetResource() const 
+    {
+        return resource;
+    }
+    // Переводит пустой список на собственный пул узлов поверх текущего
+    // источника памяти; очистка списка освобождает все узлы разом
+    void EnableNodePool() 
+    {
+        if (nodePool) return;
+        if (head) throw std::logic_error("Пул узлов можно включить только для пустого списка");
+        nodePool.reset(new NodePool(resource));
+        resource = nodePool.get();
+    }
+    bool HasNodePool() const 
+    {
+        return nodePool != nullptr;
+    }
+    std::int64_t GetLength() const 
     {
         return length;
     }
     void Append(T item) 
     {
-        Node** current = &head;
-        while (*current) 
+        Node* node = CreateNode(std::move(item));
+        if (tail) 
         {
-            current = &((*current)->next);
+            tail->next = node;
+        }
+        else 
+        {
+            head = node;
         }
-        *current = new Node(item);
+        tail = node;
         length++;
     }
     void Prepend(T item) 
     {
-        head = new Node(item, head);
+        head = CreateNode(std::move(item), head);
+        if (!tail) 
+        {
+            tail = head;
+        }
         length++;
     }
-    void InsertAt(T item, int index) 
+    void InsertAt(T item, std::int64_t index) 
     {
         if (index < 0 || index > length) throw std::out_of_range("Index out of range");
+        if (index == length) 
+        {
+            Append(std::move(item));
+            return;
+        }
         Node** current = &head;
-        for (int i = 0; i < index; i++) 
+        for (std::int64_t i = 0; i < index; i++) 
         {
             current = &((*current)->next);
         }
-        *current = new Node(item, *current);
+        *current = CreateNode(std::move(item), *current);
         length++;
     }
     LinkedList<T> Concat(const LinkedList<T>& other) const 
@@ -194,6 +348,138 @@ public:
         }
         return result;
     }
+    ConstCursor GetFirstCursor() const 
+    {
+        return ConstCursor(head);
+    }
+    Cursor GetFirstCursor() 
+    {
+        return Cursor(nullptr, head);
+    }
+    // Курсор на элемент index; index == GetLength() даёт позицию за концом
+    Cursor GetCursorAt(std::int64_t index) 
+    {
+        if (index < 0 || index > length) throw std::out_of_range("Индекс вне диапазона");
+        Cursor cursor(nullptr, head);
+        for (std::int64_t i = 0; i < index; i++) 
+        {
+            cursor.Next();
+        }
+        if (index == length) 
+        {
+            cursor.previous = tail;
+        }
+        return cursor;
+    }
+    // Вставляет элемент после позиции и возвращает курсор на него
+    Cursor InsertAfter(const Cursor& position, T item) 
+    {
+        if (!position.node) throw std::out_of_range("Курсор вне списка");
+        Node* node = CreateNode(std::move(item), position.node->next);
+        position.node->next = node;
+        if (tail == position.node) 
+        {
+            tail = node;
+        }
+        length++;
+        return Cursor(position.node, node);
+    }
+    // Удаляет элемент в позиции и возвращает курсор на следующий
+    Cursor Erase(const Cursor& position) 
+    {
+        if (!position.node) throw std::out_of_range("Курсор вне списка");
+        Node* next = position.node->next;
+        if (position.previous) 
+        {
+            position.previous->next = next;
+        }
+        else 
+        {
+            head = next;
+        }
+        if (tail == position.node) 
+        {
+            tail = position.previous;
+        }
+        DestroyNode(position.node);
+        length--;
+        return Cursor(position.previous, next);
+    }
+    // Забирает узлы other и присоединяет их в конец за O(1);
+    // other остаётся пустым
+    void Concat(LinkedList<T>&& other) 
+    {
+        if (this == &other || !other.head) return;
+        if (other.resource != resource) 
+        {
+            // Узлы чужого источника памяти нельзя перевесить: переносим значения
+            for (Node* current = other.head; current; current = current->next) 
+            {
+                Append(std::move(current->data));
+            }
+            other.Clear();
+            return;
+        }
+        if (tail) 
+        {
+            tail->next = other.head;
+        }
+        else 
+        {
+            head = other.head;
+        }
+        tail = other.tail;
+        length += other.length;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.length = 0;
+    }
+    // Устойчивая сортировка слиянием снизу вверх: узлы перевешиваются,
+    // элементы не копируются, дополнительная память O(1)
+    template <class Compare>
+    void Sort(Compare comp) 
+    {
+        if (length < 2) return;
+        for (std::int64_t width = 1; width < length; width *= 2) 
+        {
+            Node* remaining = head;
+            Node* sorted = nullptr;
+            Node** link = &sorted;
+            Node* last = nullptr;
+            while (remaining) 
+            {
+                Node* left = remaining;
+                Node* right = CutAfter(left, width);
+                remaining = CutAfter(right, width);
+                while (left && right) 
+                {
+                    // При равенстве берётся левый элемент, что сохраняет порядок равных
+                    if (comp(right->data, left->data)) 
+                    {
+                        *link = right;
+                        right = right->next;
+                    }
+                    else 
+                    {
+                        *link = left;
+                        left = left->next;
+                    }
+                    last = *link;
+                    link = &last->next;
+                }
+                Node* rest = left ? left : right;
+                *link = rest;
+                while (rest) 
+                {
+                    last = rest;
+                    rest = rest->next;
+                }
+                link = &last->next;
+            }
+            head = sorted;
+            tail = last;
+        }
+    }
 };
 
 #endif
\ No newline at end of file
@@ -3,6 +3,13 @@
 
 #include "DynamicArray.h"
 #include "LinkedList.h"
+#include "skip_list.h"
+#include <cstdint>
+#include <memory>
+
+template <class T> class ImmutableArraySequence;
+template <class T> class SliceSequence;
+template <class T, class Storage = LinkedList<T>> class ImmutableListSequence;
 
 template <class T>
 class IIterator 
@@ -35,12 +42,18 @@ public:
     virtual ~Sequence() = default;
     virtual T GetFirst() const = 0;
     virtual T GetLast() const = 0;
-    virtual T Get(int index) const = 0;
-    virtual int GetLength() const = 0;
+    virtual T Get(std::int64_t index) const = 0;
+    virtual std::int64_t GetLength() const = 0;
+    
+    // Совместимость с вызовами по индексу типа int
+    T Get(int index) const 
+    {
+        return Get(static_cast<std::int64_t>(index));
+    }
     
     T Get(size_t index) const override 
     {
-        return Get(static_cast<int>(index));
+        return Get(static_cast<std::int64_t>(index));
     }
     
     size_t GetCount() const override 
@@ -48,8 +61,70 @@ public:
         return static_cast<size_t>(GetLength());
     }
     
-    virtual Sequence<T>* GetSubsequence(int startIndex, int endIndex) const = 0;
+    virtual Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const = 0;
     virtual IIterator<T>* CreateIterator() const = 0;
+    
+    // Копирует count элементов, начиная с startIndex, в destination
+    virtual void CopyTo(T* destination, std::int64_t startIndex, std::int64_t count) const 
+    {
+        if (startIndex < 0 || count < 0 || startIndex + count > GetLength()) 
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        for (std::int64_t i = 0; i < count; i++) 
+        {
+            destination[i] = Get(startIndex + i);
+        }
+    }
+    
+    // Передаёт элементы по порядку в func(const T* items, std::int64_t count)
+    // непрерывными блоками: на всю последовательность приходится один
+    // виртуальный вызов, а внутренний цикл по блоку можно векторизовать.
+    // Указатель действителен только во время вызова func.
+    template <class Func>
+    void ForEachChunk(Func func) const 
+    {
+        VisitChunks([](void* context, const T* items, std::int64_t count) 
+        {
+            (*static_cast<Func*>(context))(items, count);
+            return true;
+        }, &func);
+    }
+    
+    // То же, но обход прекращается, как только func вернёт false
+    template <class Func>
+    void ForEachChunkWhile(Func func) const 
+    {
+        VisitChunks([](void* context, const T* items, std::int64_t count) 
+        {
+            return static_cast<bool>((*static_cast<Func*>(context))(items, count));
+        }, &func);
+    }
+
+protected:
+    static const std::int64_t ChunkBufferSize = 256;
+    
+    // Возвращает false, если обход нужно прекратить
+    using ChunkCallback = bool (*)(void* context, const T* items, std::int64_t count);
+    
+    // Обходит хранилище блоками. По умолчанию элементы читаются итератором
+    // в буфер; последовательности с непрерывным хранилищем отдают его напрямую
+    virtual void VisitChunks(ChunkCallback callback, void* context) const 
+    {
+        std::unique_ptr<IIterator<T>> iterator(CreateIterator());
+        DynamicArray<T> buffer;
+        buffer.Reserve(ChunkBufferSize);
+        while (iterator->HasNext()) 
+        {
+            buffer.PushBack(iterator->GetCurrentItem());
+            iterator->Next();
+            if (buffer.GetSize() == ChunkBufferSize || !iterator->HasNext()) 
+            {
+                if (!callback(context, buffer.Data(), buffer.GetSize())) return;
+                buffer.EraseRange(0, buffer.GetSize());
+            }
+        }
+    }
 };
 
 template <class T>
@@ -57,7 +132,7 @@ class ArrayIterator : public IIterator<T>
 {
 private:
     const ImmutableArraySequence<T>* sequence;
-    int currentIndex;
+    std::int64_t currentIndex;
 
 public:
     ArrayIterator(const ImmutableArraySequence<T>* seq) : sequence(seq), currentIndex(0) {}
@@ -90,41 +165,39 @@ public:
     }
 };
 
-template <class T>
+// Итератор держит указатель на текущий узел, поэтому полный обход занимает O(n)
+template <class T, class Storage = LinkedList<T>>
 class ListIterator : public IIterator<T> 
 {
 private:
-    const ImmutableListSequence<T>* sequence;
-    int currentIndex;
+    const ImmutableListSequence<T, Storage>* sequence;
+    typename Storage::ConstCursor cursor;
 
 public:
-    ListIterator(const ImmutableListSequence<T>* seq) : sequence(seq), currentIndex(0) {}
+    ListIterator(const ImmutableListSequence<T, Storage>* seq) : sequence(seq), cursor(seq->GetFirstCursor()) {}
 
     T GetCurrentItem() const override 
     {
-        if (currentIndex < 0 || currentIndex >= sequence->GetLength()) 
+        if (!cursor.IsValid()) 
         {
             throw std::out_of_range("Iterator is out of range");
         }
-        return sequence->Get(currentIndex);
+        return cursor.Get();
     }
 
     bool HasNext() const override 
     {
-        return currentIndex < sequence->GetLength();
+        return cursor.IsValid();
     }
 
     void Next() override 
     {
-        if (HasNext()) 
-        {
-            currentIndex++;
-        }
+        cursor.Next();
     }
 
     void Reset() override 
     {
-        currentIndex = 0;
+        cursor = sequence->GetFirstCursor();
     }
 };
 
@@ -136,9 +209,10 @@ protected:
 
 public:
     ImmutableArraySequence() : array() {}
-    ImmutableArraySequence(int size) : array(size) {}
-    ImmutableArraySequence(T* items, int count) : array(items, count) {}
+    ImmutableArraySequence(std::int64_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : array(size, resource) {}
+    ImmutableArraySequence(const T* items, std::int64_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : array(items, count, resource) {}
     ImmutableArraySequence(const DynamicArray<T>& arr) : array(arr) {}
+    ImmutableArraySequence(DynamicArray<T>&& arr) : array(std::move(arr)) {}
     ImmutableArraySequence(const ImmutableArraySequence<T>& other) : array(other.array) {}
     
     T GetFirst() const override 
@@ -153,38 +227,231 @@ public:
         return array.Get(array.GetSize() - 1);
     }
 
-    T Get(int index) const override 
+    T Get(std::int64_t index) const override 
     {
         return array.Get(index);
     }
     
-    int GetLength() const override 
+    std::int64_t GetLength() const override 
     {
         return array.GetSize();
     }
     
-    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override 
+    // Непрерывный доступ к хранилищу без виртуальных вызовов и проверок границ
+    const T& At(std::int64_t index) const 
+    {
+        return array.At(index);
+    }
+    
+    const T* Data() const 
+    {
+        return array.Data();
+    }
+    
+    const T* begin() const 
+    {
+        return array.begin();
+    }
+    
+    const T* end() const 
+    {
+        return array.end();
+    }
+    
+    ArrayView<T> GetView() const 
+    {
+        return array.GetView();
+    }
+    
+    // Возвращает срез за O(1), разделяющий буфер массива. Первый срез
+    // навсегда включает у массива копирование при записи (IsCopyOnWrite):
+    // запись в массив, пока жив срез, отделит его собственную копию.
+    // Безопасно вызывать одновременно из нескольких потоков
+    Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const override 
     {
         if (startIndex < 0 || endIndex >= array.GetSize() || startIndex > endIndex) 
         {
             throw std::out_of_range("Неверный диапазон индексов");
         }
         
-        int subLength = endIndex - startIndex + 1;
-        T* subItems = new T[subLength];
-        for (int i = 0; i < subLength; i++) 
+        array.EnableCopyOnWrite();
+        return new SliceSequence<T>(array, startIndex, endIndex - startIndex + 1);
+    }
+    
+    IIterator<T>* CreateIterator() const override 
+    {
+        return new ArrayIterator<T>(this);
+    }
+    
+    void CopyTo(T* destination, std::int64_t startIndex, std::int64_t count) const override 
+    {
+        if (startIndex < 0 || count < 0 || startIndex + count > array.GetSize()) 
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        std::copy(array.Data() + startIndex, array.Data() + startIndex + count, destination);
+    }
+
+protected:
+    void VisitChunks(typename Sequence<T>::ChunkCallback callback, void* context) const override 
+    {
+        if (array.GetSize() > 0) 
+        {
+            callback(context, array.Data(), array.GetSize());
+        }
+    }
+};
+
+// Срез массива: разделяет буфер исходной последовательности без копирования
+// элементов. Буфер живёт, пока на него ссылается хотя бы один владелец,
+// а запись в исходную изменяемую последовательность отделяет её копию,
+// поэтому срез остаётся снимком на момент создания.
+template <class T>
+class SliceSequence : public Sequence<T> 
+{
+private:
+    class SliceIterator : public IIterator<T> 
+    {
+    private:
+        const SliceSequence<T>* sequence;
+        std::int64_t currentIndex;
+    
+    public:
+        SliceIterator(const SliceSequence<T>* seq) : sequence(seq), currentIndex(0) {}
+        
+        T GetCurrentItem() const override 
+        {
+            if (currentIndex >= sequence->GetLength()) 
+            {
+                throw std::out_of_range("Iterator is out of range");
+            }
+            return sequence->At(currentIndex);
+        }
+        
+        bool HasNext() const override 
+        {
+            return currentIndex < sequence->GetLength();
+        }
+        
+        void Next() override 
         {
-            subItems[i] = array.Get(startIndex + i);
+            if (HasNext()) 
+            {
+                currentIndex++;
+            }
         }
         
-        Sequence<T>* result = new ImmutableArraySequence<T>(subItems, subLength);
-        delete[] subItems;
-        return result;
+        void Reset() override 
+        {
+            currentIndex = 0;
+        }
+    };
+    
+    DynamicArray<T> storage;
+    std::int64_t offset;
+    std::int64_t length;
+    
+    static DynamicArray<T> ShareRange(const DynamicArray<T>& source, std::int64_t startIndex, std::int64_t count) 
+    {
+        if (startIndex < 0 || count < 0 || startIndex + count > source.GetSize()) 
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        if (source.IsCopyOnWrite()) 
+        {
+            return DynamicArray<T>(source, source.GetResource());
+        }
+        // Буфер без счётчика владельцев разделить нельзя: копируется только диапазон
+        DynamicArray<T> copy(source.Data() + startIndex, count, source.GetResource());
+        copy.EnableCopyOnWrite();
+        return copy;
+    }
+
+public:
+    SliceSequence(const DynamicArray<T>& source, std::int64_t startIndex, std::int64_t count) 
+        : storage(ShareRange(source, startIndex, count)), offset(source.IsCopyOnWrite() ? startIndex : 0), length(count) {}
+    
+    T GetFirst() const override 
+    {
+        if (length == 0) throw std::out_of_range("Последовательность пуста");
+        return At(0);
+    }
+    
+    T GetLast() const override 
+    {
+        if (length == 0) throw std::out_of_range("Последовательность пуста");
+        return At(length - 1);
+    }
+    
+    T Get(std::int64_t index) const override 
+    {
+        if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
+        return At(index);
+    }
+    
+    using Sequence<T>::Get;
+    
+    std::int64_t GetLength() const override 
+    {
+        return length;
+    }
+    
+    const T& At(std::int64_t index) const 
+    {
+        return storage.At(offset + index);
+    }
+    
+    const T* Data() const 
+    {
+        return storage.Data() + offset;
+    }
+    
+    const T* begin() const 
+    {
+        return Data();
+    }
+    
+    const T* end() const 
+    {
+        return Data() + length;
+    }
+    
+    ArrayView<T> GetView() const 
+    {
+        return ArrayView<T>(Data(), length);
+    }
+    
+    // Срез среза разделяет тот же буфер
+    Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const override 
+    {
+        if (startIndex < 0 || endIndex >= length || startIndex > endIndex) 
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        return new SliceSequence<T>(storage, offset + startIndex, endIndex - startIndex + 1);
     }
     
     IIterator<T>* CreateIterator() const override 
     {
-        return new ArrayIterator<T>(this);
+        return new SliceIterator(this);
+    }
+    
+    void CopyTo(T* destination, std::int64_t startIndex, std::int64_t count) const override 
+    {
+        if (startIndex < 0 || count < 0 || startIndex + count > length) 
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        std::copy(Data() + startIndex, Data() + startIndex + count, destination);
+    }
+
+protected:
+    void VisitChunks(typename Sequence<T>::ChunkCallback callback, void* context) const override 
+    {
+        if (length > 0) 
+        {
+            callback(context, Data(), length);
+        }
     }
 };
 
@@ -195,23 +462,54 @@ public:
     using ImmutableArraySequence<T>::ImmutableArraySequence;
     
     MutableArraySequence() : ImmutableArraySequence<T>() {}
-    MutableArraySequence(int size) : ImmutableArraySequence<T>(size) {}
-    MutableArraySequence(T* items, int count) : ImmutableArraySequence<T>(items, count) {}
+    MutableArraySequence(std::int64_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : ImmutableArraySequence<T>(size, resource) {}
+    MutableArraySequence(const T* items, std::int64_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : ImmutableArraySequence<T>(items, count, resource) {}
     MutableArraySequence(const DynamicArray<T>& arr) : ImmutableArraySequence<T>(arr) {}
+    MutableArraySequence(DynamicArray<T>&& arr) : ImmutableArraySequence<T>(std::move(arr)) {}
     
-    T& GetRef(int index) 
+    using ImmutableArraySequence<T>::At;
+    using ImmutableArraySequence<T>::Data;
+    using ImmutableArraySequence<T>::begin;
+    using ImmutableArraySequence<T>::end;
+    
+    T& GetRef(std::int64_t index) 
     {
         return this->array.Get(index);
     }
     
-    void Set(int index, T value) 
+    T& At(std::int64_t index) 
+    {
+        return this->array.At(index);
+    }
+    
+    T* Data() 
+    {
+        return this->array.Data();
+    }
+    
+    T* begin() 
+    {
+        return this->array.begin();
+    }
+    
+    T* end() 
+    {
+        return this->array.end();
+    }
+    
+    void Set(std::int64_t index, T value) 
     {
         this->array.Set(index, value);
     }
     
     void Append(T item) 
     {
-        this->array.InsertAt(item, this->array.GetSize());
+        this->array.PushBack(item);
+    }
+    
+    void Reserve(std::int64_t capacity) 
+    {
+        this->array.Reserve(capacity);
     }
     
     void Prepend(T item) 
@@ -219,28 +517,40 @@ public:
         this->array.InsertAt(item, 0);
     }
     
-    void InsertAt(T item, int index) 
+    void InsertAt(T item, std::int64_t index) 
     {
         this->array.InsertAt(item, index);
     }
     
-    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override 
+    // Пакетные операции: одно выделение памяти и один сдвиг на весь диапазон
+    void AppendRange(const T* items, std::int64_t count) 
+    {
+        this->array.AppendRange(items, count);
+    }
+    
+    void InsertRange(const T* items, std::int64_t count, std::int64_t index) 
+    {
+        this->array.InsertRange(items, count, index);
+    }
+    
+    void EraseRange(std::int64_t startIndex, std::int64_t count) 
+    {
+        this->array.EraseRange(startIndex, count);
+    }
+    
+    void AssignFrom(const T* items, std::int64_t count) 
+    {
+        this->array.AssignFrom(items, count);
+    }
+    
+    Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const override 
     {
         if (startIndex < 0 || endIndex >= this->array.GetSize() || startIndex > endIndex) 
         {
             throw std::out_of_range("Неверный диапазон индексов");
         }
         
-        int subLength = endIndex - startIndex + 1;
-        T* subItems = new T[subLength];
-        for (int i = 0; i < subLength; i++) 
-        {
-            subItems[i] = this->array.Get(startIndex + i);
-        }
-        
-        Sequence<T>* result = new MutableArraySequence<T>(subItems, subLength);
-        delete[] subItems;
-        return result;
+        return new MutableArraySequence<T>(this->array.Data() + startIndex, endIndex - startIndex + 1);
     }
     
     IIterator<T>* CreateIterator() const override 
@@ -249,17 +559,21 @@ public:
     }
 };
 
-template <class T>
+// Storage — хранилище элементов: LinkedList (по умолчанию) или IndexedSkipList
+// для доступа и изменения по индексу за O(log n)
+template <class T, class Storage>
 class ImmutableListSequence : public Sequence<T> 
 {
 protected:
-    LinkedList<T> list;
+    Storage list;
 
 public:
     ImmutableListSequence() : list() {}
-    ImmutableListSequence(T* items, int count) : list(items, count) {}
-    ImmutableListSequence(const LinkedList<T>& lst) : list(lst) {}
-    ImmutableListSequence(const ImmutableListSequence<T>& other) : list(other.list) {}
+    explicit ImmutableListSequence(std::pmr::memory_resource* resource) : list(resource) {}
+    ImmutableListSequence(const T* items, std::int64_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : list(items, count, resource) {}
+    ImmutableListSequence(const Storage& lst) : list(lst) {}
+    ImmutableListSequence(Storage&& lst) : list(std::move(lst)) {}
+    ImmutableListSequence(const ImmutableListSequence<T, Storage>& other) : list(other.list) {}
     
     T GetFirst() const override 
     {
@@ -271,40 +585,83 @@ public:
         return list.GetLast();
     }
     
-    T Get(int index) const override 
+    T Get(std::int64_t index) const override 
     {
         return list.Get(index);
     }
     
-    int GetLength() const override 
+    std::int64_t GetLength() const override 
     {
         return list.GetLength();
     }
     
-    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override 
+    typename Storage::ConstCursor GetFirstCursor() const 
     {
-        LinkedList<T> subList = list.GetSubList(startIndex, endIndex);
-        return new ImmutableListSequence<T>(subList);
+        return list.GetFirstCursor();
+    }
+    
+    Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const override 
+    {
+        Storage subList = list.GetSubList(startIndex, endIndex);
+        return new ImmutableListSequence<T, Storage>(subList);
     }
     
     IIterator<T>* CreateIterator() const override 
     {
-        return new ListIterator<T>(this);
+        return new ListIterator<T, Storage>(this);
+    }
+    
+    void CopyTo(T* destination, std::int64_t startIndex, std::int64_t count) const override 
+    {
+        if (startIndex < 0 || count < 0 || startIndex + count > list.GetLength()) 
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        auto cursor = list.GetFirstCursor();
+        for (std::int64_t i = 0; i < startIndex; i++) 
+        {
+            cursor.Next();
+        }
+        for (std::int64_t i = 0; i < count; i++, cursor.Next()) 
+        {
+            destination[i] = cursor.Get();
+        }
+    }
+
+protected:
+    // Узлы проходятся курсором и копируются в буфер без виртуальных вызовов
+    void VisitChunks(typename Sequence<T>::ChunkCallback callback, void* context) const override 
+    {
+        DynamicArray<T> buffer;
+        buffer.Reserve(Sequence<T>::ChunkBufferSize);
+        for (auto cursor = list.GetFirstCursor(); cursor.IsValid(); cursor.Next()) 
+        {
+            buffer.PushBack(cursor.Get());
+            if (buffer.GetSize() == Sequence<T>::ChunkBufferSize) 
+            {
+                if (!callback(context, buffer.Data(), buffer.GetSize())) return;
+                buffer.EraseRange(0, buffer.GetSize());
+            }
+        }
+        if (buffer.GetSize() > 0) 
+        {
+            callback(context, buffer.Data(), buffer.GetSize());
+        }
     }
 };
 
-template <class T>
-class MutableListSequence : public ImmutableListSequence<T> 
+template <class T, class Storage = LinkedList<T>>
+class MutableListSequence : public ImmutableListSequence<T, Storage> 
 {
 public:
-    using ImmutableListSequence<T>::ImmutableListSequence;
+    using ImmutableListSequence<T, Storage>::ImmutableListSequence;
     
-    T& GetRef(int index) 
+    T& GetRef(std::int64_t index) 
     {
         return this->list.Get(index);
     }
     
-    void Set(int index, T value) 
+    void Set(std::int64_t index, T value) 
     {
         this->list.Get(index) = value;
     }
@@ -319,20 +676,57 @@ public:
         this->list.Prepend(item);
     }
     
-    void InsertAt(T item, int index) 
+    void InsertAt(T item, std::int64_t index) 
     {
         this->list.InsertAt(item, index);
     }
     
-    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override 
+    // Позиционные курсоры: вставка после позиции и удаление в ней за O(1)
+    // для LinkedList и за O(log n) для IndexedSkipList
+    using ImmutableListSequence<T, Storage>::GetFirstCursor;
+    
+    typename Storage::Cursor GetFirstCursor() 
+    {
+        return this->list.GetFirstCursor();
+    }
+    
+    typename Storage::Cursor GetCursorAt(std::int64_t index) 
+    {
+        return this->list.GetCursorAt(index);
+    }
+    
+    typename Storage::Cursor InsertAfter(const typename Storage::Cursor& position, T item) 
+    {
+        return this->list.InsertAfter(position, std::move(item));
+    }
+    
+    typename Storage::Cursor Erase(const typename Storage::Cursor& position) 
+    {
+        return this->list.Erase(position);
+    }
+    
+    // Устойчивая сортировка перестановкой узлов (для хранилища LinkedList)
+    template <class Compare>
+    void Sort(Compare comp) 
+    {
+        this->list.Sort(comp);
+    }
+    
+    // Присоединяет элементы other (для LinkedList за O(1)), other становится пустой
+    void Concat(MutableListSequence<T, Storage>&& other) 
+    {
+        this->list.Concat(std::move(other.list));
+    }
+    
+    Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const override 
     {
-        LinkedList<T> subList = this->list.GetSubList(startIndex, endIndex);
-        return new MutableListSequence<T>(subList);
+        Storage subList = this->list.GetSubList(startIndex, endIndex);
+        return new MutableListSequence<T, Storage>(subList);
     }
     
     IIterator<T>* CreateIterator() const override 
     {
-        return new ListIterator<T>(static_cast<const ImmutableListSequence<T>*>(this));
+        return new ListIterator<T, Storage>(static_cast<const ImmutableListSequence<T, Storage>*>(this));
     }
 };
 
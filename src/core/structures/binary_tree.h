@@ -4,9 +4,75 @@
 #include "Sequence.h"
 #include "LinkedList.h"
 #include "DynamicArray.h"
+#include "node_pool.h"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <functional>
+#include <memory_resource>
+#include <new>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Явный стек для нерекурсивных алгоритмов дерева: первые InlineCapacity
+// элементов лежат в самом объекте, более глубокие пути — в динамическом массиве
+template <typename P>
+class TreeStack 
+{
+private:
+    static const std::int64_t InlineCapacity = 64;
+    P inlineItems[InlineCapacity];
+    DynamicArray<P> overflow;
+    P* items;
+    std::int64_t capacity;
+    std::int64_t count;
+
+    void Grow() 
+    {
+        DynamicArray<P> larger(capacity * 2);
+        std::copy(items, items + count, larger.Data());
+        overflow = std::move(larger);
+        items = overflow.Data();
+        capacity *= 2;
+    }
+
+public:
+    TreeStack() : items(inlineItems), capacity(InlineCapacity), count(0) {}
+    TreeStack(const TreeStack&) = delete;
+    TreeStack& operator=(const TreeStack&) = delete;
+
+    void Push(const P& item) 
+    {
+        if (count == capacity) Grow();
+        items[count++] = item;
+    }
+
+    P& At(std::int64_t index) 
+    {
+        return items[index];
+    }
+
+    P& Top() 
+    {
+        return items[count - 1];
+    }
+
+    P Pop() 
+    {
+        return items[--count];
+    }
+
+    bool IsEmpty() const 
+    {
+        return count == 0;
+    }
+
+    std::int64_t GetCount() const 
+    {
+        return count;
+    }
+};
 
 template <typename T>
 struct Node 
@@ -14,8 +80,13 @@ struct Node
     T data;
     Node* left;
     Node* right;
+    // Высота поддерева; лист имеет высоту 1
+    int height;
+    // Число узлов в поддереве вместе с самим узлом
+    std::int64_t size;
     
-    Node(const T& value) : data(value), left(nullptr), right(nullptr) {}
+    Node(const T& value) : data(value), left(nullptr), right(nullptr), height(1), size(1) {}
+    Node(T&& value) : data(std::move(value)), left(nullptr), right(nullptr), height(1), size(1) {}
 };
 
 template <typename T>
@@ -23,114 +94,183 @@ class BinaryTree
 {
 private:
     Node<T>* root;
+    // Источник памяти под узлы; по умолчанию глобальные new/delete
+    std::pmr::memory_resource* resource;
+    // Собственный пул узлов, если он включён
+    std::unique_ptr<NodePool> nodePool;
+    // Восстанавливать ли баланс (AVL) при каждой вставке и удалении
+    bool selfBalancing;
 
-    Node<T>* insertRecursive(Node<T>* node, const T& value)
+    template <typename V>
+    Node<T>* createNode(V&& value) const
     {
-        if (node == nullptr) 
+        void* memory = resource->allocate(sizeof(Node<T>), alignof(Node<T>));
+        try 
         {
-            return new Node<T>(value);
+            return ::new (memory) Node<T>(std::forward<V>(value));
         }
-
-        if (value < node->data) 
-        {
-            node->left = insertRecursive(node->left, value);
-        } 
-        else if (node->data < value) 
+        catch (...) 
         {
-            node->right = insertRecursive(node->right, value);
+            resource->deallocate(memory, sizeof(Node<T>), alignof(Node<T>));
+            throw;
         }
-
-        return node;
     }
     
-    Node<T>* removeRecursive(Node<T>* node, const T& value)
+    void destroyNode(Node<T>* node) const
     {
-        if (node == nullptr) return nullptr;
+        node->~Node<T>();
+        resource->deallocate(node, sizeof(Node<T>), alignof(Node<T>));
+    }
 
-        if (value < node->data) 
-        {
-            node->left = removeRecursive(node->left, value);
-        } 
-        else if (node->data < value) 
-        {
-            node->right = removeRecursive(node->right, value);
-        } 
-        else 
+    // Трёхпутевое сравнение элементов по operator<
+    struct ElementCompare
+    {
+        int operator()(const T& a, const T& b) const
         {
-            if (node->left == nullptr) 
-            {
-                Node<T>* temp = node->right;
-                delete node;
-                return temp;
-            } 
-            else if (node->right == nullptr) 
-            {
-                Node<T>* temp = node->left;
-                delete node;
-                return temp;
-            }
-
-            Node<T>* temp = findMin(node->right);
-            node->data = temp->data;
-            node->right = removeRecursive(node->right, temp->data);
+            if (a < b) return -1;
+            if (b < a) return 1;
+            return 0;
         }
-        return node;
+    };
+
+    static int heightOf(Node<T>* node)
+    {
+        return node != nullptr ? node->height : 0;
     }
     
-    Node<T>* findMin(Node<T>* node) const
+    static std::int64_t sizeOf(Node<T>* node)
     {
-        while (node != nullptr && node->left != nullptr) 
-        {
-            node = node->left;
-        }
-        return node;
+        return node != nullptr ? node->size : 0;
     }
     
-    bool containsRecursive(Node<T>* node, const T& value) const
+    // Пересчитывает высоту и размер узла по его детям
+    static void updateNode(Node<T>* node)
     {
-        if (node == nullptr) return false;
-        if (node->data == value) return true;
-        if (value < node->data) return containsRecursive(node->left, value);
-        return containsRecursive(node->right, value);
+        int leftHeight = heightOf(node->left);
+        int rightHeight = heightOf(node->right);
+        node->height = (leftHeight > rightHeight ? leftHeight : rightHeight) + 1;
+        node->size = sizeOf(node->left) + sizeOf(node->right) + 1;
     }
     
-    void clearRecursive(Node<T>* node)
+    static Node<T>* rotateLeft(Node<T>* node)
     {
-        if (node != nullptr) 
+        Node<T>* pivot = node->right;
+        node->right = pivot->left;
+        pivot->left = node;
+        updateNode(node);
+        updateNode(pivot);
+        return pivot;
+    }
+    
+    static Node<T>* rotateRight(Node<T>* node)
+    {
+        Node<T>* pivot = node->left;
+        node->left = pivot->right;
+        pivot->right = node;
+        updateNode(node);
+        updateNode(pivot);
+        return pivot;
+    }
+    
+    // Обновляет высоту и размер узла после изменения одного из поддеревьев и в режиме
+    // самобалансировки восстанавливает AVL-условие одним или двумя поворотами
+    Node<T>* fixUp(Node<T>* node) const
+    {
+        updateNode(node);
+        if (!selfBalancing) return node;
+        int difference = heightOf(node->left) - heightOf(node->right);
+        if (difference > 1) 
+        {
+            if (heightOf(node->left->left) < heightOf(node->left->right)) 
+            {
+                node->left = rotateLeft(node->left);
+            }
+            return rotateRight(node);
+        }
+        if (difference < -1) 
         {
-            clearRecursive(node->left);
-            clearRecursive(node->right);
-            delete node;
+            if (heightOf(node->right->right) < heightOf(node->right->left)) 
+            {
+                node->right = rotateRight(node->right);
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    // Поднимается по пройденному пути до корня, обновляя высоты и размеры
+    // поддеревьев и при необходимости выполняя повороты
+    void fixPath(TreeStack<Node<T>**>& path)
+    {
+        while (!path.IsEmpty()) 
+        {
+            Node<T>** link = path.Pop();
+            *link = fixUp(*link);
         }
     }
     
-    Node<T>* copyTree(Node<T>* node) const
+    // Разрушает дерево без рекурсии и без дополнительной памяти: левые
+    // поддеревья поворотами переносятся вправо, и узлы удаляются по цепочке
+    template <typename Destroy>
+    static void destroyTree(Node<T>* node, Destroy destroy)
     {
-        if (node == nullptr) return nullptr;
-        Node<T>* newNode = new Node<T>(node->data);
-        newNode->left = copyTree(node->left);
-        newNode->right = copyTree(node->right);
-        return newNode;
+        while (node != nullptr) 
+        {
+            if (node->left != nullptr) 
+            {
+                Node<T>* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } 
+            else 
+            {
+                Node<T>* right = node->right;
+                destroy(node);
+                node = right;
+            }
+        }
     }
     
-    // Методы для балансировки
-    void storeInOrder(Node<T>* node, MutableArraySequence<T>& arr) const
+    Node<T>* copyTree(Node<T>* source) const
     {
-        if (node == nullptr) return;
-        storeInOrder(node->left, arr);
-        arr.Append(node->data);
-        storeInOrder(node->right, arr);
+        Node<T>* result = nullptr;
+        TreeStack<std::pair<Node<T>*, Node<T>**>> pending;
+        pending.Push(std::make_pair(source, &result));
+        try 
+        {
+            while (!pending.IsEmpty()) 
+            {
+                std::pair<Node<T>*, Node<T>**> item = pending.Pop();
+                if (item.first == nullptr) continue;
+                Node<T>* newNode = createNode(item.first->data);
+                newNode->height = item.first->height;
+                newNode->size = item.first->size;
+                *item.second = newNode;
+                pending.Push(std::make_pair(item.first->right, &newNode->right));
+                pending.Push(std::make_pair(item.first->left, &newNode->left));
+            }
+        } 
+        catch (...) 
+        {
+            // Уже скопированная часть — корректное дерево, его узлы освобождаются
+            destroyTree(result, [this](Node<T>* node) { destroyNode(node); });
+            throw;
+        }
+        return result;
     }
     
-    Node<T>* buildBalancedTree(const MutableArraySequence<T>& arr, int start, int end)
+    // Глубина рекурсии — log2 n, так как дерево строится идеально сбалансированным
+    Node<T>* buildBalancedTree(const MutableArraySequence<T>& arr, std::int64_t start, std::int64_t end)
     {
         if (start > end) return nullptr;
         
-        int mid = (start + end) / 2;
-        Node<T>* node = new Node<T>(arr.Get(mid));
+        std::int64_t mid = (start + end) / 2;
+        Node<T>* node = createNode(arr.Get(mid));
         
         node->left = buildBalancedTree(arr, start, mid - 1);
         node->right = buildBalancedTree(arr, mid + 1, end);
+        updateNode(node);
         
         return node;
     }
@@ -141,12 +281,12 @@ private:
         std::string str = std::to_string(value);
         for (char c : str) 
         {
-            buffer.InsertAt(c, buffer.GetSize());
+            buffer.PushBack(c);
         }
-        buffer.InsertAt(' ', buffer.GetSize());
+        buffer.PushBack(' ');
     }
     
-    T stringToValue(const DynamicArray<char>& buffer, int& pos) const
+    T stringToValue(const DynamicArray<char>& buffer, std::int64_t& pos) const
     {
         std::string str;
         while (pos < buffer.GetSize() && buffer[pos] != ' ') 
@@ -173,34 +313,10 @@ private:
         }
     }
     
-    void serializePreOrder(Node<T>* node, DynamicArray<char>& buffer) const
-    {
-        if (node == nullptr) return;
-        valueToString(node->data, buffer);
-        serializePreOrder(node->left, buffer);
-        serializePreOrder(node->right, buffer);
-    }
-    
-    void serializeInOrder(Node<T>* node, DynamicArray<char>& buffer) const
-    {
-        if (node == nullptr) return;
-        serializeInOrder(node->left, buffer);
-        valueToString(node->data, buffer);
-        serializeInOrder(node->right, buffer);
-    }
-    
-    void serializePostOrder(Node<T>* node, DynamicArray<char>& buffer) const
-    {
-        if (node == nullptr) return;
-        serializePostOrder(node->left, buffer);
-        serializePostOrder(node->right, buffer);
-        valueToString(node->data, buffer);
-    }
-    
     bool compareFormats(const DynamicArray<char>& format1, const DynamicArray<char>& format2) const
     {
         if (format1.GetSize() != format2.GetSize()) return false;
-        for (int i = 0; i < format1.GetSize(); i++) 
+        for (std::int64_t i = 0; i < format1.GetSize(); i++) 
         {
             if (format1[i] != format2[i]) return false;
         }
@@ -212,20 +328,15 @@ private:
     private:
         const BinaryTree<T>* tree;
         MutableArraySequence<T> elements;
-        int currentIndex;
-
-        void collectElements(Node<T>* node) 
-        {
-            if (node == nullptr) return;
-            collectElements(node->left);
-            elements.Append(node->data);
-            collectElements(node->right);
-        }
+        std::int64_t currentIndex;
 
     public:
         TreeIterator(const BinaryTree<T>* bt) : tree(bt), currentIndex(0) 
         {
-            collectElements(tree->root);
+            tree->traverseInOrder([this](const T& value) 
+            {
+                elements.Append(value);
+            });
         }
 
         T GetCurrentItem() const override 
@@ -257,9 +368,11 @@ private:
     };
 
 public:
-    BinaryTree() : root(nullptr) {}
+    BinaryTree(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : root(nullptr), resource(resource), selfBalancing(false) {}
     
-    BinaryTree(const BinaryTree& other) 
+    // Копия, как и в std::pmr, использует источник памяти по умолчанию;
+    // режим самобалансировки копируется вместе с формой дерева
+    BinaryTree(const BinaryTree& other, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : root(nullptr), resource(resource), selfBalancing(other.selfBalancing)
     {
         root = copyTree(other.root);
     }
@@ -270,6 +383,7 @@ public:
         {
             clear();
             root = copyTree(other.root);
+            selfBalancing = other.selfBalancing;
         }
         return *this;
     }
@@ -281,17 +395,144 @@ public:
 
     void insert(const T& value) 
     {
-        root = insertRecursive(root, value);
+        TreeStack<Node<T>**> path;
+        Node<T>** link = &root;
+        while (*link != nullptr) 
+        {
+            Node<T>* node = *link;
+            path.Push(link);
+            if (value < node->data) 
+            {
+                link = &node->left;
+            } 
+            else if (node->data < value) 
+            {
+                link = &node->right;
+            } 
+            else 
+            {
+                return;
+            }
+        }
+        *link = createNode(value);
+        fixPath(path);
+    }
+    
+    // Находит элемент, равный value, или вставляет value за один спуск.
+    // Возвращает ссылку на элемент в дереве: её можно менять на месте, если
+    // изменение не затрагивает порядок (например, счётчик при ключе). Ссылка
+    // остаётся действительной до удаления элемента — повороты перевешивают
+    // узлы, не перемещая данные. В inserted, если он передан, записывается,
+    // был ли элемент вставлен
+    T& findOrInsert(const T& value, bool* inserted = nullptr) 
+    {
+        return findOrInsertWith(value, ElementCompare(), [&value]() -> const T& { return value; }, inserted);
     }
     
     void remove(const T& value) 
     {
-        root = removeRecursive(root, value);
+        removeWith(value, ElementCompare());
+    }
+    
+    // Варианты поиска по ключу другого типа (прозрачное сравнение):
+    // compare(key, element) возвращает отрицательное число, 0 или
+    // положительное, если key меньше, равен или больше element в порядке
+    // дерева. Ни пробный элемент, ни копия ключа не создаются
+    template <typename K, typename Compare>
+    Node<T>* findNodeWith(const K& key, Compare compare) const 
+    {
+        Node<T>* current = root;
+        while (current != nullptr) 
+        {
+            int order = compare(key, current->data);
+            if (order == 0) return current;
+            current = order < 0 ? current->left : current->right;
+        }
+        return nullptr;
+    }
+    
+    // make() строит элемент только если ключа в дереве нет
+    template <typename K, typename Compare, typename Make>
+    T& findOrInsertWith(const K& key, Compare compare, Make make, bool* inserted = nullptr) 
+    {
+        TreeStack<Node<T>**> path;
+        Node<T>** link = &root;
+        while (*link != nullptr) 
+        {
+            Node<T>* node = *link;
+            int order = compare(key, node->data);
+            if (order == 0) 
+            {
+                if (inserted != nullptr) *inserted = false;
+                return node->data;
+            }
+            path.Push(link);
+            link = order < 0 ? &node->left : &node->right;
+        }
+        Node<T>* node = createNode(make());
+        *link = node;
+        fixPath(path);
+        if (inserted != nullptr) *inserted = true;
+        return node->data;
+    }
+    
+    // Возвращает, был ли элемент удалён
+    template <typename K, typename Compare>
+    bool removeWith(const K& key, Compare compare) 
+    {
+        TreeStack<Node<T>**> path;
+        Node<T>** link = &root;
+        while (*link != nullptr) 
+        {
+            Node<T>* node = *link;
+            int order = compare(key, node->data);
+            if (order == 0) break;
+            path.Push(link);
+            link = order < 0 ? &node->left : &node->right;
+        }
+        Node<T>* node = *link;
+        if (node == nullptr) return false;
+
+        if (node->left == nullptr) 
+        {
+            *link = node->right;
+        } 
+        else if (node->right == nullptr) 
+        {
+            *link = node->left;
+        } 
+        else 
+        {
+            // Место удаляемого узла занимает его преемник: узлы
+            // перевешиваются, данные не копируются
+            path.Push(link);
+            std::int64_t rightIndex = path.GetCount();
+            Node<T>** minLink = &node->right;
+            while ((*minLink)->left != nullptr) 
+            {
+                path.Push(minLink);
+                minLink = &(*minLink)->left;
+            }
+            Node<T>* successor = *minLink;
+            *minLink = successor->right;
+            successor->left = node->left;
+            successor->right = node->right;
+            successor->height = node->height;
+            successor->size = node->size;
+            *link = successor;
+            if (path.GetCount() > rightIndex) 
+            {
+                path.At(rightIndex) = &successor->right;
+            }
+        }
+        destroyNode(node);
+        fixPath(path);
+        return true;
     }
     
     bool contains(const T& value) const 
     {
-        return containsRecursive(root, value);
+        return findNode(value) != nullptr;
     }
     
     bool isEmpty() const 
@@ -301,75 +542,186 @@ public:
     
     void clear() 
     {
-        clearRecursive(root);
+        if (nodePool) 
+        {
+            // Память всех узлов возвращается пулу одним шагом
+            if constexpr (!std::is_trivially_destructible<T>::value) 
+            {
+                destroyTree(root, [](Node<T>* node) { node->~Node<T>(); });
+            }
+            nodePool->Release();
+            root = nullptr;
+            return;
+        }
+        destroyTree(root, [this](Node<T>* node) { destroyNode(node); });
         root = nullptr;
     }
     
+    // Переводит пустое дерево на собственный пул узлов поверх текущего
+    // источника памяти: узлы нарезаются из плит, clear освобождает их разом
+    void enableNodePool() 
+    {
+        if (nodePool) return;
+        if (root != nullptr) throw std::logic_error("Пул узлов можно включить только для пустого дерева");
+        nodePool.reset(new NodePool(resource));
+        resource = nodePool.get();
+    }
+    
+    bool hasNodePool() const 
+    {
+        return nodePool != nullptr;
+    }
+    
+    // Включает AVL-балансировку: высота дерева остаётся O(log n) после любой
+    // вставки и удаления, в том числе при поступлении ключей по порядку.
+    // Уже построенное дерево один раз перестраивается
+    void enableSelfBalancing() 
+    {
+        if (selfBalancing) return;
+        balance();
+        selfBalancing = true;
+    }
+    
+    bool isSelfBalancing() const 
+    {
+        return selfBalancing;
+    }
+    
+    int getHeight() const 
+    {
+        return heightOf(root);
+    }
+    
+    // Число элементов за O(1)
+    std::int64_t size() const 
+    {
+        return sizeOf(root);
+    }
+    
+    // k-й по порядку элемент (с нуля) за O(h)
+    const T& select(std::int64_t k) const 
+    {
+        if (k < 0 || k >= sizeOf(root)) throw std::out_of_range("Индекс вне диапазона");
+        Node<T>* node = root;
+        while (true) 
+        {
+            std::int64_t leftSize = sizeOf(node->left);
+            if (k == leftSize) return node->data;
+            if (k < leftSize) 
+            {
+                node = node->left;
+            } 
+            else 
+            {
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+    }
+    
+    // Число элементов, меньших value, за O(h)
+    std::int64_t rank(const T& value) const 
+    {
+        std::int64_t result = 0;
+        Node<T>* node = root;
+        while (node != nullptr) 
+        {
+            if (node->data < value) 
+            {
+                result += sizeOf(node->left) + 1;
+                node = node->right;
+            } 
+            else 
+            {
+                node = node->left;
+            }
+        }
+        return result;
+    }
+    
     Node<T>* getRoot() const 
     { 
         return root; 
     }
+    
+    std::pmr::memory_resource* getResource() const 
+    {
+        return resource;
+    }
 
     void balance() 
     {
         if (root == nullptr) return;
         
         MutableArraySequence<T> elements;
-        storeInOrder(root, elements);
+        traverseInOrder([&elements](const T& value) 
+        {
+            elements.Append(value);
+        });
         
         clear();
         root = buildBalancedTree(elements, 0, elements.GetLength() - 1);
     }
 
-    // Обходы
+    // Обходы выполняются с явным стеком и не зависят от глубины дерева
     template <typename Func>
     void traversePreOrder(Func func) const 
     {
-        struct TraversalHelper 
-        {
-            static void preOrder(Node<T>* node, Func func) 
-            {
-                if (node == nullptr) return;
-                func(node->data);
-                preOrder(node->left, func);
-                preOrder(node->right, func);
-            }
-        };
-        
-        TraversalHelper::preOrder(root, func);
+        if (root == nullptr) return;
+        TreeStack<Node<T>*> stack;
+        stack.Push(root);
+        while (!stack.IsEmpty()) 
+        {
+            Node<T>* node = stack.Pop();
+            func(node->data);
+            if (node->right != nullptr) stack.Push(node->right);
+            if (node->left != nullptr) stack.Push(node->left);
+        }
     }
     
     template <typename Func>
     void traverseInOrder(Func func) const 
     {
-        struct TraversalHelper 
+        TreeStack<Node<T>*> stack;
+        Node<T>* node = root;
+        while (node != nullptr || !stack.IsEmpty()) 
         {
-            static void inOrder(Node<T>* node, Func func) 
+            while (node != nullptr) 
             {
-                if (node == nullptr) return;
-                inOrder(node->left, func);
-                func(node->data);
-                inOrder(node->right, func);
+                stack.Push(node);
+                node = node->left;
             }
-        };
-        
-        TraversalHelper::inOrder(root, func);
+            node = stack.Pop();
+            func(node->data);
+            node = node->right;
+        }
     }
     
     template <typename Func>
     void traversePostOrder(Func func) const 
     {
-        struct TraversalHelper {
-            static void postOrder(Node<T>* node, Func func) 
+        TreeStack<Node<T>*> stack;
+        Node<T>* node = root;
+        Node<T>* lastVisited = nullptr;
+        while (node != nullptr || !stack.IsEmpty()) 
+        {
+            if (node != nullptr) 
             {
-                if (node == nullptr) return;
-                postOrder(node->left, func);
-                postOrder(node->right, func);
-                func(node->data);
+                stack.Push(node);
+                node = node->left;
+                continue;
             }
-        };
-        
-        TraversalHelper::postOrder(root, func);
+            Node<T>* top = stack.Top();
+            if (top->right != nullptr && top->right != lastVisited) 
+            {
+                node = top->right;
+            } 
+            else 
+            {
+                func(top->data);
+                lastVisited = stack.Pop();
+            }
+        }
     }
 
     // Функциональные операции
@@ -421,7 +773,7 @@ public:
         Node<T>* node = findNode(value);
         if (node != nullptr) 
         {
-            result.root = copyTree(node);
+            result.root = result.copyTree(node);
         }
         return result;
     }
@@ -437,7 +789,7 @@ public:
         DynamicArray<char> otherSubtree = subtree.serialize();
         
         if (thisSubtree.GetSize() != otherSubtree.GetSize()) return false;
-        for (int i = 0; i < thisSubtree.GetSize(); i++) 
+        for (std::int64_t i = 0; i < thisSubtree.GetSize(); i++) 
         {
             if (thisSubtree[i] != otherSubtree[i]) return false;
         }
@@ -483,17 +835,21 @@ public:
         lpkFormat.InsertAt('P', 1);
         lpkFormat.InsertAt('K', 2);
         
+        auto write = [this, &buffer](const T& value) 
+        {
+            valueToString(value, buffer);
+        };
         if (compareFormats(format, klpFormat)) 
         {
-            serializePreOrder(root, buffer);
+            traversePreOrder(write);
         }
         else if (compareFormats(format, lkpFormat)) 
         {
-            serializeInOrder(root, buffer);
+            traverseInOrder(write);
         }
         else if (compareFormats(format, lpkFormat)) 
         {
-            serializePostOrder(root, buffer);
+            traversePostOrder(write);
         }
         else 
         {
@@ -516,7 +872,7 @@ public:
     {
         clear();
         
-        int pos = 0;
+        std::int64_t pos = 0;
         while (pos < str.GetSize()) 
         {
             try 
@@ -2,6 +2,8 @@
 #define DICTIONARY_H
 
 #include "binary_tree.h"
+#include "small_string.h"
+#include "string_compare.h"
 
 // Структура для сравнения пар по ключу
 template<typename TKey, typename TValue>
@@ -23,30 +25,12 @@ struct PairComparator<DynamicArray<char>, int>
 {
     static bool less(const std::pair<DynamicArray<char>, int>& a, const std::pair<DynamicArray<char>, int>& b) 
     {
-        int minSize;
-        if (a.first.GetSize() < b.first.GetSize()) 
-        {
-            minSize = a.first.GetSize();
-        } 
-        else 
-        {
-            minSize = b.first.GetSize();
-        }
-        for (int i = 0; i < minSize; i++) 
-        {
-            if (a.first.Get(i) < b.first.Get(i)) return true;
-            if (b.first.Get(i) < a.first.Get(i)) return false;
-        }
-        return a.first.GetSize() < b.first.GetSize();
+        return CompareCharRanges(a.first.Data(), a.first.GetSize(), b.first.Data(), b.first.GetSize()) < 0;
     }
     
     static bool equal(const std::pair<DynamicArray<char>, int>& a, const std::pair<DynamicArray<char>, int>& b) 
     {
-        if (a.first.GetSize() != b.first.GetSize()) return false;
-        for (int i = 0; i < a.first.GetSize(); i++) {
-            if (a.first.Get(i) != b.first.Get(i)) return false;
-        }
-        return true;
+        return CharRangesEqual(a.first.Data(), a.first.GetSize(), b.first.Data(), b.first.GetSize());
     }
 };
 
@@ -90,56 +74,197 @@ public:
     }
 };
 
+// Трёхпутевое сравнение искомого ключа с ключом пары в порядке DictionaryPair.
+// Словарь ищет по нему прямо по ключу, не собирая пробную пару
+template <typename TKey>
+struct KeyComparator 
+{
+    static int compare(const TKey& probe, const TKey& key) 
+    {
+        if (probe < key) return -1;
+        if (key < probe) return 1;
+        return 0;
+    }
+};
+
+// Строковые ключи сравниваются одним проходом; искать можно и по
+// заимствованному диапазону символов ArrayView<char> без построения ключа
+template <>
+struct KeyComparator<SmallString> 
+{
+    static int compare(const SmallString& probe, const SmallString& key) 
+    {
+        return CompareCharRanges(probe.Data(), probe.GetSize(), key.Data(), key.GetSize());
+    }
+
+    static int compare(const ArrayView<char>& probe, const SmallString& key) 
+    {
+        return CompareCharRanges(probe.Data(), probe.GetSize(), key.Data(), key.GetSize());
+    }
+};
+
+template <>
+struct KeyComparator<DynamicArray<char>> 
+{
+    static int compare(const DynamicArray<char>& probe, const DynamicArray<char>& key) 
+    {
+        return CompareCharRanges(probe.Data(), probe.GetSize(), key.Data(), key.GetSize());
+    }
+
+    static int compare(const ArrayView<char>& probe, const DynamicArray<char>& key) 
+    {
+        return CompareCharRanges(probe.Data(), probe.GetSize(), key.Data(), key.GetSize());
+    }
+};
+
 template <typename TKey, typename TValue>
 class Dictionary 
 {
 private:
     BinaryTree<DictionaryPair<TKey, TValue>> tree;
 
-public:
-    Dictionary() = default;
-
-    void Add(TKey key, TValue value) 
+    struct PairKeyCompare 
     {
-        DictionaryPair<TKey, TValue> pair(key, value);
-        DictionaryPair<TKey, TValue> searchPair(key, TValue());
-        if (tree.contains(searchPair)) 
+        template <typename Probe>
+        int operator()(const Probe& key, const DictionaryPair<TKey, TValue>& pair) const 
         {
-            tree.remove(searchPair);
+            return KeyComparator<TKey>::compare(key, pair.getKey());
         }
-        tree.insert(pair);
+    };
+
+    template <typename Probe>
+    const DictionaryPair<TKey, TValue>* FindPair(const Probe& key) const 
+    {
+        auto node = tree.findNodeWith(key, PairKeyCompare());
+        return node != nullptr ? &node->data : nullptr;
     }
 
-    bool ContainsKey(TKey key) const 
+    // Пара для ключа; новая пара строится из key и initial только при вставке
+    DictionaryPair<TKey, TValue>& FindOrInsertPair(const TKey& key, const TValue& initial, bool* inserted) 
     {
-        DictionaryPair<TKey, TValue> searchPair(key, TValue());
-        return tree.contains(searchPair);
+        return tree.findOrInsertWith(key, PairKeyCompare(), [&key, &initial]() 
+        {
+            return DictionaryPair<TKey, TValue>(key, initial);
+        }, inserted);
     }
 
-    TValue Get(TKey key) const 
+    template <typename Probe>
+    TValue GetValue(const Probe& key) const 
     {
-        DictionaryPair<TKey, TValue> searchPair(key, TValue());
-        auto node = tree.findNode(searchPair);
-        if (node != nullptr) {
-            return node->data.getValue();
+        const DictionaryPair<TKey, TValue>* pair = FindPair(key);
+        if (pair != nullptr) 
+        {
+            return pair->getValue();
         }
         throw std::runtime_error("Key not found");
     }
 
-    void Remove(TKey key) 
+public:
+    // Дерево словаря балансируется при каждой вставке и удалении
+    Dictionary() 
     {
-        DictionaryPair<TKey, TValue> searchPair(key, TValue());
-        tree.remove(searchPair);
+        tree.enableSelfBalancing();
+    }
+    explicit Dictionary(std::pmr::memory_resource* resource) : tree(resource) 
+    {
+        tree.enableSelfBalancing();
     }
 
-    int GetCount() const 
+    // Добавляет пару или заменяет значение существующего ключа за один спуск
+    void Add(const TKey& key, const TValue& value) 
     {
-        int count = 0;
-        tree.traverseInOrder([&count](const DictionaryPair<TKey, TValue>& pair) 
+        bool inserted = false;
+        DictionaryPair<TKey, TValue>& pair = FindOrInsertPair(key, value, &inserted);
+        if (!inserted) 
         {
-            count++;
-        });
-        return count;
+            pair.getValue() = value;
+        }
+    }
+
+    // Значение по ключу; отсутствующий ключ добавляется со значением TValue().
+    // Ссылка действительна до удаления ключа
+    TValue& FindOrInsert(const TKey& key) 
+    {
+        return tree.findOrInsertWith(key, PairKeyCompare(), [&key]() 
+        {
+            return DictionaryPair<TKey, TValue>(key, TValue());
+        }).getValue();
+    }
+
+    // Добавляет value для нового ключа, иначе заменяет текущее значение на
+    // combiner(текущее, value); значение меняется на месте за один спуск
+    template <typename Combiner>
+    void AddOrUpdate(const TKey& key, const TValue& value, Combiner combiner) 
+    {
+        bool inserted = false;
+        DictionaryPair<TKey, TValue>& pair = FindOrInsertPair(key, value, &inserted);
+        if (!inserted) 
+        {
+            pair.getValue() = combiner(pair.getValue(), value);
+        }
+    }
+
+    // Прибавляет delta к значению ключа; новый ключ получает значение delta
+    void Increment(const TKey& key, const TValue& delta) 
+    {
+        bool inserted = false;
+        DictionaryPair<TKey, TValue>& pair = FindOrInsertPair(key, delta, &inserted);
+        if (!inserted) 
+        {
+            pair.getValue() += delta;
+        }
+    }
+
+    // Поиск идёт прямо по ключу: пробная пара, копия ключа и значение
+    // по умолчанию не создаются. Перегрузки с ArrayView<char> доступны для
+    // строковых ключей и не требуют построения ключа вовсе
+
+    // Указатель на значение ключа или nullptr — поиск и чтение за один спуск
+    const TValue* Find(const TKey& key) const 
+    {
+        const DictionaryPair<TKey, TValue>* pair = FindPair(key);
+        return pair != nullptr ? &pair->getValue() : nullptr;
+    }
+
+    const TValue* Find(const ArrayView<char>& key) const 
+    {
+        const DictionaryPair<TKey, TValue>* pair = FindPair(key);
+        return pair != nullptr ? &pair->getValue() : nullptr;
+    }
+
+    bool ContainsKey(const TKey& key) const 
+    {
+        return FindPair(key) != nullptr;
+    }
+
+    bool ContainsKey(const ArrayView<char>& key) const 
+    {
+        return FindPair(key) != nullptr;
+    }
+
+    TValue Get(const TKey& key) const 
+    {
+        return GetValue(key);
+    }
+
+    TValue Get(const ArrayView<char>& key) const 
+    {
+        return GetValue(key);
+    }
+
+    void Remove(const TKey& key) 
+    {
+        tree.removeWith(key, PairKeyCompare());
+    }
+
+    void Remove(const ArrayView<char>& key) 
+    {
+        tree.removeWith(key, PairKeyCompare());
+    }
+
+    std::int64_t GetCount() const 
+    {
+        return tree.size();
     }
 
     bool IsEmpty() const 
@@ -152,6 +277,12 @@ public:
         tree.clear();
     }
 
+    // Узлы берутся из собственного пула, Clear освобождает их разом
+    void EnableNodePool() 
+    {
+        tree.enableNodePool();
+    }
+
     // Для получения всех ключей
     template<typename Func>
     void ForEachKey(Func func) const 
@@ -205,10 +336,10 @@ public:
     }
 
     // Проверка наличия значения
-    bool ContainsValue(TValue value) const 
+    bool ContainsValue(const TValue& value) const 
     {
         bool found = false;
-        ForEachValue([&found, value](const TValue& val) 
+        ForEachValue([&found, &value](const TValue& val) 
         {
             if (val == value) 
             {
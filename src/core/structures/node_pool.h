@@ -0,0 +1,262 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// Пул блоков фиксированного размера для узлов списков и деревьев.
+// Память берётся у вышестоящего источника крупными плитами, из которых
+// нарезаются блоки; освобождённые блоки попадают в список свободных своего
+// класса размера и переиспользуются. Крупные и сверхвыровненные запросы
+// уходят к вышестоящему источнику, но тоже учитываются пулом.
+// Release возвращает все плиты и крупные блоки разом.
+// Пул не потокобезопасен: предполагается один пул на контейнер.
+class NodePool : public std::pmr::memory_resource
+{
+public:
+    static const std::size_t BlockAlignment = alignof(std::max_align_t);
+    static const std::size_t MaxBlockSize = 256;
+
+private:
+    static const std::size_t ClassCount = MaxBlockSize / BlockAlignment;
+    static const std::size_t MinSlabSize = 4096;
+    static const std::size_t MaxSlabSize = 1 << 20;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct Slab
+    {
+        Slab* next;
+        std::size_t size;
+    };
+
+    // Заголовок крупного блока: лежит перед выданной памятью и связывает
+    // все крупные блоки в двусвязный список
+    struct LargeBlock
+    {
+        LargeBlock* previous;
+        LargeBlock* next;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    std::pmr::memory_resource* upstream;
+    FreeBlock* freeLists[ClassCount];
+    Slab* slabs;
+    LargeBlock* largeBlocks;
+    char* cursor;
+    char* limit;
+    std::size_t nextSlabSize;
+    std::int64_t blocksInUse;
+
+    static std::size_t SlabHeaderSize()
+    {
+        return (sizeof(Slab) + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+    }
+
+    static std::size_t ClassIndex(std::size_t bytes)
+    {
+        if (bytes == 0) return 0;
+        return (bytes + BlockAlignment - 1) / BlockAlignment - 1;
+    }
+
+    static bool IsLarge(std::size_t bytes, std::size_t alignment)
+    {
+        return bytes > MaxBlockSize || alignment > BlockAlignment;
+    }
+
+    static std::size_t LargeAlignment(std::size_t alignment)
+    {
+        return alignment > alignof(LargeBlock) ? alignment : alignof(LargeBlock);
+    }
+
+    // Смещение выданной памяти от начала крупного блока: заголовок,
+    // округлённый вверх до требуемого выравнивания
+    static std::size_t LargeHeaderSize(std::size_t alignment)
+    {
+        std::size_t align = LargeAlignment(alignment);
+        return (sizeof(LargeBlock) + align - 1) / align * align;
+    }
+
+    void* AllocateLarge(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t headerSize = LargeHeaderSize(alignment);
+        char* base = static_cast<char*>(upstream->allocate(headerSize + bytes, LargeAlignment(alignment)));
+        LargeBlock* block = reinterpret_cast<LargeBlock*>(base + headerSize - sizeof(LargeBlock));
+        block->previous = nullptr;
+        block->next = largeBlocks;
+        block->bytes = bytes;
+        block->alignment = alignment;
+        if (largeBlocks != nullptr)
+        {
+            largeBlocks->previous = block;
+        }
+        largeBlocks = block;
+        return base + headerSize;
+    }
+
+    void ReleaseLarge(LargeBlock* block)
+    {
+        std::size_t headerSize = LargeHeaderSize(block->alignment);
+        char* base = reinterpret_cast<char*>(block) + sizeof(LargeBlock) - headerSize;
+        upstream->deallocate(base, headerSize + block->bytes, LargeAlignment(block->alignment));
+    }
+
+    void DeallocateLarge(void* pointer)
+    {
+        LargeBlock* block = reinterpret_cast<LargeBlock*>(static_cast<char*>(pointer) - sizeof(LargeBlock));
+        if (block->previous != nullptr)
+        {
+            block->previous->next = block->next;
+        }
+        else
+        {
+            largeBlocks = block->next;
+        }
+        if (block->next != nullptr)
+        {
+            block->next->previous = block->previous;
+        }
+        ReleaseLarge(block);
+    }
+
+    void AddSlab(std::size_t minBytes)
+    {
+        std::size_t size = nextSlabSize;
+        while (size < SlabHeaderSize() + minBytes)
+        {
+            size *= 2;
+        }
+        Slab* slab = static_cast<Slab*>(upstream->allocate(size, BlockAlignment));
+        slab->next = slabs;
+        slab->size = size;
+        slabs = slab;
+        cursor = reinterpret_cast<char*>(slab) + SlabHeaderSize();
+        limit = reinterpret_cast<char*>(slab) + size;
+        if (nextSlabSize < MaxSlabSize)
+        {
+            nextSlabSize *= 2;
+        }
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (IsLarge(bytes, alignment))
+        {
+            return AllocateLarge(bytes, alignment);
+        }
+        std::size_t index = ClassIndex(bytes);
+        blocksInUse++;
+        if (freeLists[index] != nullptr)
+        {
+            FreeBlock* block = freeLists[index];
+            freeLists[index] = block->next;
+            return block;
+        }
+        std::size_t blockSize = (index + 1) * BlockAlignment;
+        if (cursor == nullptr || static_cast<std::size_t>(limit - cursor) < blockSize)
+        {
+            AddSlab(blockSize);
+        }
+        void* block = cursor;
+        cursor += blockSize;
+        return block;
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        if (IsLarge(bytes, alignment))
+        {
+            DeallocateLarge(pointer);
+            return;
+        }
+        std::size_t index = ClassIndex(bytes);
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->next = freeLists[index];
+        freeLists[index] = block;
+        blocksInUse--;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    explicit NodePool(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream(upstream), slabs(nullptr), largeBlocks(nullptr), cursor(nullptr), limit(nullptr), nextSlabSize(MinSlabSize), blocksInUse(0)
+    {
+        for (std::size_t i = 0; i < ClassCount; i++)
+        {
+            freeLists[i] = nullptr;
+        }
+    }
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    ~NodePool()
+    {
+        Release();
+    }
+
+    // Возвращает все плиты и крупные блоки вышестоящему источнику.
+    // Блоки, выданные пулом, становятся недействительными
+    void Release()
+    {
+        while (largeBlocks != nullptr)
+        {
+            LargeBlock* next = largeBlocks->next;
+            ReleaseLarge(largeBlocks);
+            largeBlocks = next;
+        }
+        while (slabs != nullptr)
+        {
+            Slab* next = slabs->next;
+            upstream->deallocate(slabs, slabs->size, BlockAlignment);
+            slabs = next;
+        }
+        for (std::size_t i = 0; i < ClassCount; i++)
+        {
+            freeLists[i] = nullptr;
+        }
+        cursor = nullptr;
+        limit = nullptr;
+        nextSlabSize = MinSlabSize;
+        blocksInUse = 0;
+    }
+
+    std::pmr::memory_resource* GetUpstream() const
+    {
+        return upstream;
+    }
+    // Количество выданных и ещё не возвращённых блоков
+    std::int64_t GetBlocksInUse() const
+    {
+        return blocksInUse;
+    }
+    std::int64_t GetSlabCount() const
+    {
+        std::int64_t count = 0;
+        for (Slab* slab = slabs; slab != nullptr; slab = slab->next)
+        {
+            count++;
+        }
+        return count;
+    }
+    // Количество крупных блоков, выданных напрямую из вышестоящего источника
+    std::int64_t GetLargeBlockCount() const
+    {
+        std::int64_t count = 0;
+        for (LargeBlock* block = largeBlocks; block != nullptr; block = block->next)
+        {
+            count++;
+        }
+        return count;
+    }
+};
+
+#endif
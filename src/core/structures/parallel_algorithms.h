@@ -0,0 +1,195 @@
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include "Sequence.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Параллельные алгоритмы над Sequence на общем пуле потоков.
+// Массивы и срезы обрабатываются прямо в своём буфере; остальные
+// последовательности сначала копируются в массив одним вызовом CopyTo.
+// Разбиение на блоки зависит только от длины входа, поэтому ParallelReduce
+// и ParallelInclusiveScan дают одинаковый результат при любом числе потоков.
+
+// Размер блока, на который делится работа
+const std::int64_t ParallelGrainSize = 4096;
+
+// Непрерывное хранилище последовательности или nullptr
+template <class T>
+const T* ContiguousData(const Sequence<T>* sequence)
+{
+    if (auto arraySequence = dynamic_cast<const ImmutableArraySequence<T>*>(sequence))
+    {
+        return arraySequence->Data();
+    }
+    if (auto sliceSequence = dynamic_cast<const SliceSequence<T>*>(sequence))
+    {
+        return sliceSequence->Data();
+    }
+    return nullptr;
+}
+
+// Возвращает указатель на элементы; при необходимости копирует их в buffer
+template <class T>
+const T* AcquireContiguous(const Sequence<T>* sequence, DynamicArray<T>& buffer)
+{
+    const T* data = ContiguousData(sequence);
+    if (data != nullptr || sequence->GetLength() == 0) return data;
+    buffer.Resize(sequence->GetLength());
+    sequence->CopyTo(buffer.Data(), 0, sequence->GetLength());
+    return buffer.Data();
+}
+
+template <class T, class Func, class U = typename std::decay<decltype(std::declval<Func&>()(std::declval<const T&>()))>::type>
+MutableArraySequence<U> ParallelMap(const Sequence<T>* sequence, Func func, ThreadPool& pool = ThreadPool::Shared())
+{
+    DynamicArray<T> buffer;
+    const T* input = AcquireContiguous(sequence, buffer);
+    std::int64_t length = sequence->GetLength();
+    DynamicArray<U> output(length);
+    U* result = output.Data();
+    pool.ParallelFor(length, ParallelGrainSize, [input, result, &func](std::int64_t begin, std::int64_t end)
+    {
+        for (std::int64_t i = begin; i < end; i++)
+        {
+            result[i] = func(input[i]);
+        }
+    });
+    return MutableArraySequence<U>(std::move(output));
+}
+
+// Свёртка с ассоциативной операцией op. Частичные суммы блоков
+// объединяются слева направо в фиксированном порядке
+template <class T, class Op = std::plus<T>>
+T ParallelReduce(const Sequence<T>* sequence, T identity, Op op = Op(), ThreadPool& pool = ThreadPool::Shared())
+{
+    DynamicArray<T> buffer;
+    const T* input = AcquireContiguous(sequence, buffer);
+    std::int64_t length = sequence->GetLength();
+    std::int64_t blocks = (length + ParallelGrainSize - 1) / ParallelGrainSize;
+    DynamicArray<T> partials(blocks);
+    T* partialData = partials.Data();
+    pool.ParallelFor(blocks, 1, [input, length, partialData, &identity, &op](std::int64_t first, std::int64_t last)
+    {
+        for (std::int64_t block = first; block < last; block++)
+        {
+            std::int64_t begin = block * ParallelGrainSize;
+            std::int64_t end = std::min(begin + ParallelGrainSize, length);
+            T accumulator = identity;
+            for (std::int64_t i = begin; i < end; i++)
+            {
+                accumulator = op(accumulator, input[i]);
+            }
+            partialData[block] = accumulator;
+        }
+    });
+    T result = identity;
+    for (std::int64_t block = 0; block < blocks; block++)
+    {
+        result = op(result, partialData[block]);
+    }
+    return result;
+}
+
+// Включающая префиксная свёртка: result[i] = input[0] op ... op input[i].
+// Два прохода: суммы блоков, затем сканирование каждого блока со своим смещением
+template <class T, class Op = std::plus<T>>
+MutableArraySequence<T> ParallelInclusiveScan(const Sequence<T>* sequence, Op op = Op(), ThreadPool& pool = ThreadPool::Shared())
+{
+    DynamicArray<T> buffer;
+    const T* input = AcquireContiguous(sequence, buffer);
+    std::int64_t length = sequence->GetLength();
+    DynamicArray<T> output(length);
+    if (length == 0) return MutableArraySequence<T>(std::move(output));
+    T* result = output.Data();
+    std::int64_t blocks = (length + ParallelGrainSize - 1) / ParallelGrainSize;
+
+    // Сканирование внутри блоков
+    pool.ParallelFor(blocks, 1, [input, result, length, &op](std::int64_t first, std::int64_t last)
+    {
+        for (std::int64_t block = first; block < last; block++)
+        {
+            std::int64_t begin = block * ParallelGrainSize;
+            std::int64_t end = std::min(begin + ParallelGrainSize, length);
+            result[begin] = input[begin];
+            for (std::int64_t i = begin + 1; i < end; i++)
+            {
+                result[i] = op(result[i - 1], input[i]);
+            }
+        }
+    });
+    // Смещения блоков: последовательно по последним элементам
+    DynamicArray<T> offsets(blocks);
+    T* offsetData = offsets.Data();
+    for (std::int64_t block = 1; block < blocks; block++)
+    {
+        T last = result[block * ParallelGrainSize - 1];
+        offsetData[block] = block == 1 ? last : op(offsetData[block - 1], last);
+    }
+    pool.ParallelFor(blocks - 1, 1, [result, length, offsetData, &op](std::int64_t first, std::int64_t last)
+    {
+        for (std::int64_t block = first + 1; block < last + 1; block++)
+        {
+            std::int64_t begin = block * ParallelGrainSize;
+            std::int64_t end = std::min(begin + ParallelGrainSize, length);
+            for (std::int64_t i = begin; i < end; i++)
+            {
+                result[i] = op(offsetData[block], result[i]);
+            }
+        }
+    });
+    return MutableArraySequence<T>(std::move(output));
+}
+
+// Устойчивая параллельная сортировка: блоки сортируются независимо, затем
+// сливаются попарно, на каждом уровне слияния пары обрабатываются параллельно
+template <class T, class Compare = std::less<T>>
+void ParallelSort(MutableArraySequence<T>& sequence, Compare comp = Compare(), ThreadPool& pool = ThreadPool::Shared())
+{
+    std::int64_t length = sequence.GetLength();
+    if (length < 2) return;
+    T* data = sequence.Data();
+    std::int64_t run = ParallelGrainSize;
+    std::int64_t blocks = (length + run - 1) / run;
+    pool.ParallelFor(blocks, 1, [data, length, run, &comp](std::int64_t first, std::int64_t last)
+    {
+        for (std::int64_t block = first; block < last; block++)
+        {
+            std::int64_t begin = block * run;
+            std::int64_t end = std::min(begin + run, length);
+            std::stable_sort(data + begin, data + end, comp);
+        }
+    });
+    if (blocks == 1) return;
+
+    DynamicArray<T> scratch(length);
+    T* from = data;
+    T* to = scratch.Data();
+    for (; run < length; run *= 2)
+    {
+        std::int64_t pairs = (length + 2 * run - 1) / (2 * run);
+        pool.ParallelFor(pairs, 1, [from, to, length, run, &comp](std::int64_t first, std::int64_t last)
+        {
+            for (std::int64_t pair = first; pair < last; pair++)
+            {
+                std::int64_t begin = pair * 2 * run;
+                std::int64_t middle = std::min(begin + run, length);
+                std::int64_t end = std::min(begin + 2 * run, length);
+                std::merge(std::make_move_iterator(from + begin), std::make_move_iterator(from + middle),
+                           std::make_move_iterator(from + middle), std::make_move_iterator(from + end),
+                           to + begin, comp);
+            }
+        });
+        std::swap(from, to);
+    }
+    if (from != data)
+    {
+        std::move(from, from + length, data);
+    }
+}
+
+#endif
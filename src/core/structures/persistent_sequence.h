@@ -0,0 +1,381 @@
+#ifndef PERSISTENT_SEQUENCE_H
+#define PERSISTENT_SEQUENCE_H
+
+#include "Sequence.h"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+// Персистентная последовательность: сбалансированное (AVL) дерево по
+// позициям с неизменяемыми узлами. Append, Set, InsertAt, RemoveAt и Concat
+// не меняют текущую версию, а возвращают новую за O(log n); новая версия
+// копирует только путь от корня до изменённого места и разделяет остальные
+// узлы со старой. GetSubsequence тоже разделяет узлы и работает за O(log n).
+template <class T>
+class PersistentSequence : public Sequence<T>
+{
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node
+    {
+        T data;
+        std::int64_t size;
+        int height;
+        NodePtr left;
+        NodePtr right;
+
+        Node(NodePtr left, T value, NodePtr right)
+            : data(std::move(value)), size(Size(left) + Size(right) + 1),
+              height((Height(left) > Height(right) ? Height(left) : Height(right)) + 1),
+              left(std::move(left)), right(std::move(right)) {}
+    };
+
+    // Высота AVL-дерева не превышает 1.45 * log2(n + 2)
+    static const int MaxHeight = 96;
+
+    class PersistentIterator : public IIterator<T>
+    {
+    private:
+        const PersistentSequence<T>* sequence;
+        const Node* stack[MaxHeight];
+        int depth;
+
+        void PushLeftPath(const Node* node)
+        {
+            while (node != nullptr)
+            {
+                stack[depth++] = node;
+                node = node->left.get();
+            }
+        }
+
+    public:
+        PersistentIterator(const PersistentSequence<T>* seq) : sequence(seq), depth(0)
+        {
+            PushLeftPath(seq->root.get());
+        }
+
+        T GetCurrentItem() const override
+        {
+            if (depth == 0)
+            {
+                throw std::out_of_range("Iterator is out of range");
+            }
+            return stack[depth - 1]->data;
+        }
+
+        bool HasNext() const override
+        {
+            return depth > 0;
+        }
+
+        void Next() override
+        {
+            if (depth == 0) return;
+            const Node* node = stack[--depth];
+            PushLeftPath(node->right.get());
+        }
+
+        void Reset() override
+        {
+            depth = 0;
+            PushLeftPath(sequence->root.get());
+        }
+    };
+
+    NodePtr root;
+    std::pmr::memory_resource* resource;
+
+    PersistentSequence(NodePtr root, std::pmr::memory_resource* resource) : root(std::move(root)), resource(resource) {}
+
+    static std::int64_t Size(const NodePtr& node)
+    {
+        return node ? node->size : 0;
+    }
+
+    static int Height(const NodePtr& node)
+    {
+        return node ? node->height : 0;
+    }
+
+    NodePtr MakeNode(NodePtr left, T value, NodePtr right) const
+    {
+        return std::allocate_shared<Node>(std::pmr::polymorphic_allocator<Node>(resource), std::move(left), std::move(value), std::move(right));
+    }
+
+    // Собирает узел из поддеревьев, высоты которых различаются не более чем на 2,
+    // восстанавливая баланс одним или двумя поворотами
+    NodePtr Balance(NodePtr left, T value, NodePtr right) const
+    {
+        if (Height(left) > Height(right) + 1)
+        {
+            if (Height(left->left) >= Height(left->right))
+            {
+                return MakeNode(left->left, left->data, MakeNode(left->right, std::move(value), std::move(right)));
+            }
+            const NodePtr& middle = left->right;
+            return MakeNode(MakeNode(left->left, left->data, middle->left), middle->data, MakeNode(middle->right, std::move(value), std::move(right)));
+        }
+        if (Height(right) > Height(left) + 1)
+        {
+            if (Height(right->right) >= Height(right->left))
+            {
+                return MakeNode(MakeNode(std::move(left), std::move(value), right->left), right->data, right->right);
+            }
+            const NodePtr& middle = right->left;
+            return MakeNode(MakeNode(std::move(left), std::move(value), middle->left), middle->data, MakeNode(middle->right, right->data, right->right));
+        }
+        return MakeNode(std::move(left), std::move(value), std::move(right));
+    }
+
+    // Соединяет деревья произвольной высоты через средний элемент за O(|hl - hr|)
+    NodePtr Join(const NodePtr& left, T value, const NodePtr& right) const
+    {
+        if (Height(left) > Height(right) + 1)
+        {
+            return Balance(left->left, left->data, Join(left->right, std::move(value), right));
+        }
+        if (Height(right) > Height(left) + 1)
+        {
+            return Balance(Join(left, std::move(value), right->left), right->data, right->right);
+        }
+        return MakeNode(left, std::move(value), right);
+    }
+
+    // Отделяет первый элемент дерева
+    NodePtr SplitFirst(const NodePtr& node, T& first) const
+    {
+        if (!node->left)
+        {
+            first = node->data;
+            return node->right;
+        }
+        NodePtr rest = SplitFirst(node->left, first);
+        return Balance(std::move(rest), node->data, node->right);
+    }
+
+    NodePtr Merge(const NodePtr& left, const NodePtr& right) const
+    {
+        if (!left) return right;
+        if (!right) return left;
+        T first = right->data;
+        NodePtr rest = SplitFirst(right, first);
+        return Join(left, std::move(first), rest);
+    }
+
+    // Делит дерево на первые count элементов и остальные
+    void Split(const NodePtr& node, std::int64_t count, NodePtr& left, NodePtr& right) const
+    {
+        if (!node)
+        {
+            left = nullptr;
+            right = nullptr;
+            return;
+        }
+        std::int64_t leftSize = Size(node->left);
+        if (count <= leftSize)
+        {
+            NodePtr rest;
+            Split(node->left, count, left, rest);
+            right = Join(rest, node->data, node->right);
+        }
+        else
+        {
+            NodePtr rest;
+            Split(node->right, count - leftSize - 1, rest, right);
+            left = Join(node->left, node->data, rest);
+        }
+    }
+
+    NodePtr InsertNode(const NodePtr& node, std::int64_t index, T value) const
+    {
+        if (!node)
+        {
+            return MakeNode(nullptr, std::move(value), nullptr);
+        }
+        std::int64_t leftSize = Size(node->left);
+        if (index <= leftSize)
+        {
+            return Balance(InsertNode(node->left, index, std::move(value)), node->data, node->right);
+        }
+        return Balance(node->left, node->data, InsertNode(node->right, index - leftSize - 1, std::move(value)));
+    }
+
+    NodePtr RemoveNode(const NodePtr& node, std::int64_t index) const
+    {
+        std::int64_t leftSize = Size(node->left);
+        if (index == leftSize)
+        {
+            return Merge(node->left, node->right);
+        }
+        if (index < leftSize)
+        {
+            return Balance(RemoveNode(node->left, index), node->data, node->right);
+        }
+        return Balance(node->left, node->data, RemoveNode(node->right, index - leftSize - 1));
+    }
+
+    NodePtr SetNode(const NodePtr& node, std::int64_t index, T value) const
+    {
+        std::int64_t leftSize = Size(node->left);
+        if (index == leftSize)
+        {
+            return MakeNode(node->left, std::move(value), node->right);
+        }
+        if (index < leftSize)
+        {
+            return MakeNode(SetNode(node->left, index, std::move(value)), node->data, node->right);
+        }
+        return MakeNode(node->left, node->data, SetNode(node->right, index - leftSize - 1, std::move(value)));
+    }
+
+    // Строит идеально сбалансированное дерево из массива за O(n)
+    NodePtr Build(const T* items, std::int64_t count) const
+    {
+        if (count == 0) return nullptr;
+        std::int64_t middle = count / 2;
+        NodePtr left = Build(items, middle);
+        NodePtr right = Build(items + middle + 1, count - middle - 1);
+        return MakeNode(std::move(left), items[middle], std::move(right));
+    }
+
+    const Node* FindNode(std::int64_t index) const
+    {
+        if (index < 0 || index >= Size(root)) throw std::out_of_range("Индекс вне диапазона");
+        const Node* node = root.get();
+        while (true)
+        {
+            std::int64_t leftSize = Size(node->left);
+            if (index == leftSize) return node;
+            if (index < leftSize)
+            {
+                node = node->left.get();
+            }
+            else
+            {
+                index -= leftSize + 1;
+                node = node->right.get();
+            }
+        }
+    }
+
+public:
+    // Узлы всех версий, порождённых этой последовательностью, берутся из resource
+    PersistentSequence(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : root(nullptr), resource(resource) {}
+    PersistentSequence(const T* items, std::int64_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : root(nullptr), resource(resource)
+    {
+        if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
+        root = Build(items, count);
+    }
+    // Копирование версии стоит O(1): узлы разделяются
+    PersistentSequence(const PersistentSequence<T>& other) = default;
+    PersistentSequence<T>& operator=(const PersistentSequence<T>& other) = default;
+
+    T GetFirst() const override
+    {
+        if (!root) throw std::out_of_range("Последовательность пуста");
+        return FindNode(0)->data;
+    }
+
+    T GetLast() const override
+    {
+        if (!root) throw std::out_of_range("Последовательность пуста");
+        return FindNode(root->size - 1)->data;
+    }
+
+    T Get(std::int64_t index) const override
+    {
+        return FindNode(index)->data;
+    }
+
+    using Sequence<T>::Get;
+
+    const T& At(std::int64_t index) const
+    {
+        return FindNode(index)->data;
+    }
+
+    std::int64_t GetLength() const override
+    {
+        return Size(root);
+    }
+
+    std::int64_t GetHeight() const
+    {
+        return Height(root);
+    }
+
+    std::pmr::memory_resource* GetResource() const
+    {
+        return resource;
+    }
+
+    // Разделяют ли версии корень, то есть совпадают ли они целиком
+    bool SharesRootWith(const PersistentSequence<T>& other) const
+    {
+        return root == other.root;
+    }
+
+    PersistentSequence<T> Append(T item) const
+    {
+        return InsertAt(std::move(item), GetLength());
+    }
+
+    PersistentSequence<T> Prepend(T item) const
+    {
+        return InsertAt(std::move(item), 0);
+    }
+
+    PersistentSequence<T> InsertAt(T item, std::int64_t index) const
+    {
+        if (index < 0 || index > GetLength()) throw std::out_of_range("Индекс вне диапазона");
+        return PersistentSequence<T>(InsertNode(root, index, std::move(item)), resource);
+    }
+
+    PersistentSequence<T> RemoveAt(std::int64_t index) const
+    {
+        if (index < 0 || index >= GetLength()) throw std::out_of_range("Индекс вне диапазона");
+        return PersistentSequence<T>(RemoveNode(root, index), resource);
+    }
+
+    PersistentSequence<T> Set(std::int64_t index, T value) const
+    {
+        if (index < 0 || index >= GetLength()) throw std::out_of_range("Индекс вне диапазона");
+        return PersistentSequence<T>(SetNode(root, index, std::move(value)), resource);
+    }
+
+    // Обе версии остаются действительными; результат разделяет узлы с ними
+    PersistentSequence<T> Concat(const PersistentSequence<T>& other) const
+    {
+        return PersistentSequence<T>(Merge(root, other.root), resource);
+    }
+
+    PersistentSequence<T> Slice(std::int64_t startIndex, std::int64_t endIndex) const
+    {
+        if (startIndex < 0 || endIndex >= GetLength() || startIndex > endIndex)
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        NodePtr head, rest, middle, tail;
+        Split(root, startIndex, head, rest);
+        Split(rest, endIndex - startIndex + 1, middle, tail);
+        return PersistentSequence<T>(std::move(middle), resource);
+    }
+
+    Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const override
+    {
+        return new PersistentSequence<T>(Slice(startIndex, endIndex));
+    }
+
+    IIterator<T>* CreateIterator() const override
+    {
+        return new PersistentIterator(this);
+    }
+};
+
+#endif
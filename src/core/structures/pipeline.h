@@ -0,0 +1,304 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "Sequence.h"
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Ленивые конвейеры над Sequence: From(seq).Where(p).Map(f).Take(k).Reduce(...).
+// Операторы только описывают вычисление; терминальная операция проходит
+// источник один раз блоками ForEachChunkWhile и передаёт каждый элемент
+// через всю цепочку без промежуточных контейнеров. Take прекращает обход
+// источника, как только набрано нужное число элементов.
+//
+// Каждая стадия реализует Run(sink): вызывает sink(value) для своих элементов
+// и прекращает работу, если sink вернул false. GetSizeHint — верхняя оценка
+// числа элементов; IsExactSize сообщает, что оценка точна (в цепочке нет
+// фильтров), и только тогда ToArraySequence заранее резервирует память.
+
+template <class T>
+class SequenceStage
+{
+private:
+    const Sequence<T>* sequence;
+
+public:
+    explicit SequenceStage(const Sequence<T>* sequence) : sequence(sequence) {}
+
+    template <class Sink>
+    void Run(Sink& sink) const
+    {
+        sequence->ForEachChunkWhile([&sink](const T* items, std::int64_t count)
+        {
+            for (std::int64_t i = 0; i < count; i++)
+            {
+                if (!sink(items[i])) return false;
+            }
+            return true;
+        });
+    }
+
+    std::int64_t GetSizeHint() const
+    {
+        return sequence->GetLength();
+    }
+
+    bool IsExactSize() const
+    {
+        return true;
+    }
+};
+
+template <class Source, class Predicate>
+class WhereStage
+{
+private:
+    Source source;
+    Predicate predicate;
+
+public:
+    WhereStage(Source source, Predicate predicate) : source(std::move(source)), predicate(std::move(predicate)) {}
+
+    template <class Sink>
+    void Run(Sink& sink) const
+    {
+        auto filter = [this, &sink](const auto& value)
+        {
+            return predicate(value) ? sink(value) : true;
+        };
+        source.Run(filter);
+    }
+
+    std::int64_t GetSizeHint() const
+    {
+        return source.GetSizeHint();
+    }
+
+    bool IsExactSize() const
+    {
+        return false;
+    }
+};
+
+template <class Source, class Func>
+class MapStage
+{
+private:
+    Source source;
+    Func func;
+
+public:
+    MapStage(Source source, Func func) : source(std::move(source)), func(std::move(func)) {}
+
+    template <class Sink>
+    void Run(Sink& sink) const
+    {
+        auto transform = [this, &sink](const auto& value)
+        {
+            return sink(func(value));
+        };
+        source.Run(transform);
+    }
+
+    std::int64_t GetSizeHint() const
+    {
+        return source.GetSizeHint();
+    }
+
+    bool IsExactSize() const
+    {
+        return source.IsExactSize();
+    }
+};
+
+template <class Source>
+class TakeStage
+{
+private:
+    Source source;
+    std::int64_t limit;
+
+public:
+    TakeStage(Source source, std::int64_t limit) : source(std::move(source)), limit(limit) {}
+
+    template <class Sink>
+    void Run(Sink& sink) const
+    {
+        if (limit == 0) return;
+        std::int64_t taken = 0;
+        auto take = [this, &sink, &taken](const auto& value)
+        {
+            if (!sink(value)) return false;
+            return ++taken < limit;
+        };
+        source.Run(take);
+    }
+
+    std::int64_t GetSizeHint() const
+    {
+        std::int64_t hint = source.GetSizeHint();
+        return hint < limit ? hint : limit;
+    }
+
+    bool IsExactSize() const
+    {
+        return source.IsExactSize();
+    }
+};
+
+template <class Source>
+class SkipStage
+{
+private:
+    Source source;
+    std::int64_t count;
+
+public:
+    SkipStage(Source source, std::int64_t count) : source(std::move(source)), count(count) {}
+
+    template <class Sink>
+    void Run(Sink& sink) const
+    {
+        std::int64_t skipped = 0;
+        auto skip = [this, &sink, &skipped](const auto& value)
+        {
+            if (skipped < count)
+            {
+                skipped++;
+                return true;
+            }
+            return sink(value);
+        };
+        source.Run(skip);
+    }
+
+    std::int64_t GetSizeHint() const
+    {
+        std::int64_t hint = source.GetSizeHint() - count;
+        return hint > 0 ? hint : 0;
+    }
+
+    bool IsExactSize() const
+    {
+        return source.IsExactSize();
+    }
+};
+
+// Конвейер со значениями типа T; Stage — цепочка стадий, построенная операторами
+template <class T, class Stage>
+class Pipeline
+{
+private:
+    Stage stage;
+
+public:
+    explicit Pipeline(Stage stage) : stage(std::move(stage)) {}
+
+    template <class Predicate>
+    Pipeline<T, WhereStage<Stage, Predicate>> Where(Predicate predicate) const
+    {
+        return Pipeline<T, WhereStage<Stage, Predicate>>(WhereStage<Stage, Predicate>(stage, std::move(predicate)));
+    }
+
+    template <class Func, class U = typename std::decay<decltype(std::declval<Func&>()(std::declval<const T&>()))>::type>
+    Pipeline<U, MapStage<Stage, Func>> Map(Func func) const
+    {
+        return Pipeline<U, MapStage<Stage, Func>>(MapStage<Stage, Func>(stage, std::move(func)));
+    }
+
+    Pipeline<T, TakeStage<Stage>> Take(std::int64_t count) const
+    {
+        if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
+        return Pipeline<T, TakeStage<Stage>>(TakeStage<Stage>(stage, count));
+    }
+
+    Pipeline<T, SkipStage<Stage>> Skip(std::int64_t count) const
+    {
+        if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
+        return Pipeline<T, SkipStage<Stage>>(SkipStage<Stage>(stage, count));
+    }
+
+    template <class Func>
+    void ForEach(Func func) const
+    {
+        auto sink = [&func](const T& value)
+        {
+            func(value);
+            return true;
+        };
+        stage.Run(sink);
+    }
+
+    // Свёртка слева направо: accumulator = func(accumulator, value)
+    template <class Accumulator, class Func>
+    Accumulator Reduce(Accumulator initial, Func func) const
+    {
+        Accumulator accumulator = std::move(initial);
+        auto sink = [&accumulator, &func](const T& value)
+        {
+            accumulator = func(std::move(accumulator), value);
+            return true;
+        };
+        stage.Run(sink);
+        return accumulator;
+    }
+
+    std::int64_t Count() const
+    {
+        std::int64_t count = 0;
+        auto sink = [&count](const T&)
+        {
+            count++;
+            return true;
+        };
+        stage.Run(sink);
+        return count;
+    }
+
+    template <class Predicate>
+    bool Any(Predicate predicate) const
+    {
+        bool found = false;
+        auto sink = [&found, &predicate](const T& value)
+        {
+            found = predicate(value);
+            return !found;
+        };
+        stage.Run(sink);
+        return found;
+    }
+
+    // Без фильтров размер известен заранее и память резервируется один раз;
+    // после Where результат растёт по мере добавления, а не занимает длину источника
+    MutableArraySequence<T> ToArraySequence(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
+    {
+        DynamicArray<T> items(0, resource);
+        if (stage.IsExactSize())
+        {
+            items.Reserve(stage.GetSizeHint());
+        }
+        auto sink = [&items](const T& value)
+        {
+            items.PushBack(value);
+            return true;
+        };
+        stage.Run(sink);
+        return MutableArraySequence<T>(std::move(items));
+    }
+};
+
+template <class T>
+Pipeline<T, SequenceStage<T>> From(const Sequence<T>* sequence)
+{
+    return Pipeline<T, SequenceStage<T>>(SequenceStage<T>(sequence));
+}
+
+template <class T>
+Pipeline<T, SequenceStage<T>> From(const Sequence<T>& sequence)
+{
+    return From(&sequence);
+}
+
+#endif
@@ -12,7 +12,10 @@ private:
     std::function<bool(const T&, const T&)> comparator;
 
 public:
-    PriorityQueue(std::function<bool(const T&, const T&)> comp = std::less<T>()) : comparator(comp) {}
+    PriorityQueue(std::function<bool(const T&, const T&)> comp = std::less<T>(), std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : tree(resource), comparator(comp) 
+    {
+        tree.enableSelfBalancing();
+    }
 
     void Enqueue(const T& value) 
     {
@@ -69,14 +72,9 @@ public:
         return tree.isEmpty();
     }
 
-    int GetCount() const 
+    std::int64_t GetCount() const 
     {
-        int count = 0;
-        tree.traverseInOrder([&count](const T& value) 
-        {
-            count++;
-        });
-        return count;
+        return tree.size();
     }
 
     void Clear() 
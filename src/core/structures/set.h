@@ -10,7 +10,15 @@ private:
     BinaryTree<T> tree;
 
 public:
-    Set() = default;
+    // Дерево множества балансируется при каждой вставке и удалении
+    Set() 
+    {
+        tree.enableSelfBalancing();
+    }
+    explicit Set(std::pmr::memory_resource* resource) : tree(resource) 
+    {
+        tree.enableSelfBalancing();
+    }
 
     void Add(const T& value) 
     {
@@ -30,14 +38,9 @@ public:
         return tree.contains(value);
     }
 
-    int GetCount() const 
+    std::int64_t GetCount() const 
     {
-        int count = 0;
-        tree.traverseInOrder([&count](const T& value) 
-        {
-            count++;
-        });
-        return count;
+        return tree.size();
     }
 
     bool IsEmpty() const 
@@ -50,6 +53,12 @@ public:
         tree.clear();
     }
 
+    // Узлы берутся из собственного пула, Clear освобождает их разом
+    void EnableNodePool() 
+    {
+        tree.enableNodePool();
+    }
+
     template<typename Func>
     void ForEach(Func func) const 
     {
@@ -0,0 +1,485 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Индексируемый список с пропусками. Каждая ссылка уровня хранит ширину —
+// число шагов нижнего уровня до следующего узла, поэтому доступ, вставка
+// и удаление по позиции выполняются за ожидаемое O(log n).
+// Интерфейс совпадает с LinkedList, и список можно использовать как
+// хранилище для MutableListSequence.
+template <class T>
+class IndexedSkipList
+{
+private:
+    static const int MaxLevel = 32;
+
+    struct Node;
+
+    struct Link
+    {
+        Node* next;
+        std::int64_t width;
+    };
+
+    struct Node
+    {
+        T data;
+        int height;
+        Link* links;
+        Node(T value, int height, Link* links) : data(std::move(value)), height(height), links(links) {}
+    };
+
+    Link headLinks[MaxLevel];
+    int level;
+    Node* tail;
+    std::int64_t length;
+    std::uint64_t randomState;
+    std::pmr::memory_resource* resource;
+
+    // Высота нового узла: каждый следующий уровень с вероятностью 1/4
+    int RandomHeight()
+    {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 7;
+        randomState ^= randomState << 17;
+        std::uint64_t bits = randomState;
+        int height = 1;
+        while (height < MaxLevel && (bits & 3) == 0)
+        {
+            height++;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    static std::size_t NodeBytes(int height)
+    {
+        return sizeof(Node) + sizeof(Link) * static_cast<std::size_t>(height);
+    }
+
+    Node* CreateNode(T value, int height)
+    {
+        void* memory = resource->allocate(NodeBytes(height), alignof(Node));
+        Link* links = reinterpret_cast<Link*>(static_cast<char*>(memory) + sizeof(Node));
+        try
+        {
+            return ::new (memory) Node(std::move(value), height, links);
+        }
+        catch (...)
+        {
+            resource->deallocate(memory, NodeBytes(height), alignof(Node));
+            throw;
+        }
+    }
+
+    void DestroyNode(Node* node)
+    {
+        int height = node->height;
+        node->~Node();
+        resource->deallocate(node, NodeBytes(height), alignof(Node));
+    }
+
+    Link* LinksOf(Node* node)
+    {
+        if (node == nullptr) return headLinks;
+        return node->links;
+    }
+
+    // Узел с позицией index
+    Node* FindNode(std::int64_t index) const
+    {
+        const Link* links = headLinks;
+        Node* node = nullptr;
+        std::int64_t position = -1;
+        for (int l = level - 1; l >= 0; l--)
+        {
+            while (links[l].next != nullptr && position + links[l].width <= index)
+            {
+                position += links[l].width;
+                node = links[l].next;
+                links = node->links;
+            }
+        }
+        return node;
+    }
+
+    // Для каждого уровня запоминает последний узел перед позицией index
+    // (nullptr означает голову) и его позицию
+    void FindPredecessors(std::int64_t index, Node** update, std::int64_t* positions)
+    {
+        Node* node = nullptr;
+        std::int64_t position = -1;
+        for (int l = level - 1; l >= 0; l--)
+        {
+            Link* links = LinksOf(node);
+            while (links[l].next != nullptr && position + links[l].width < index)
+            {
+                position += links[l].width;
+                node = links[l].next;
+                links = node->links;
+            }
+            update[l] = node;
+            positions[l] = position;
+        }
+    }
+
+    void Clear()
+    {
+        Node* current = headLinks[0].next;
+        while (current != nullptr)
+        {
+            Node* next = current->links[0].next;
+            DestroyNode(current);
+            current = next;
+        }
+        for (int l = 0; l < MaxLevel; l++)
+        {
+            headLinks[l].next = nullptr;
+            headLinks[l].width = 0;
+        }
+        level = 1;
+        tail = nullptr;
+        length = 0;
+    }
+
+    void CopyFrom(const IndexedSkipList<T>& other)
+    {
+        for (Node* current = other.headLinks[0].next; current != nullptr; current = current->links[0].next)
+        {
+            Append(current->data);
+        }
+    }
+
+    void StealFrom(IndexedSkipList<T>& other)
+    {
+        for (int l = 0; l < MaxLevel; l++)
+        {
+            headLinks[l] = other.headLinks[l];
+            other.headLinks[l].next = nullptr;
+            other.headLinks[l].width = 0;
+        }
+        level = other.level;
+        tail = other.tail;
+        length = other.length;
+        other.level = 1;
+        other.tail = nullptr;
+        other.length = 0;
+    }
+
+public:
+    // Позиция для чтения: переход к следующему элементу за O(1)
+    class ConstCursor
+    {
+    private:
+        friend class IndexedSkipList<T>;
+        const Node* node;
+        explicit ConstCursor(const Node* node) : node(node) {}
+    public:
+        ConstCursor() : node(nullptr) {}
+        bool IsValid() const
+        {
+            return node != nullptr;
+        }
+        const T& Get() const
+        {
+            if (!node) throw std::out_of_range("Курсор вне списка");
+            return node->data;
+        }
+        void Next()
+        {
+            if (node)
+            {
+                node = node->links[0].next;
+            }
+        }
+    };
+    // Позиция для изменения: помнит индекс, поэтому вставка после позиции
+    // и удаление в ней выполняются за O(log n)
+    class Cursor
+    {
+    private:
+        friend class IndexedSkipList<T>;
+        Node* node;
+        std::int64_t index;
+        Cursor(Node* node, std::int64_t index) : node(node), index(index) {}
+    public:
+        Cursor() : node(nullptr), index(0) {}
+        bool IsValid() const
+        {
+            return node != nullptr;
+        }
+        T& Get() const
+        {
+            if (!node) throw std::out_of_range("Курсор вне списка");
+            return node->data;
+        }
+        void Next()
+        {
+            if (node)
+            {
+                node = node->links[0].next;
+                index++;
+            }
+        }
+    };
+
+    IndexedSkipList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : level(1), tail(nullptr), length(0), randomState(0x9E3779B97F4A7C15ULL), resource(resource)
+    {
+        for (int l = 0; l < MaxLevel; l++)
+        {
+            headLinks[l].next = nullptr;
+            headLinks[l].width = 0;
+        }
+    }
+    IndexedSkipList(const T* items, std::int64_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : IndexedSkipList(resource)
+    {
+        for (std::int64_t i = 0; i < count; i++)
+        {
+            Append(items[i]);
+        }
+    }
+    // Копия, как и в std::pmr, использует источник памяти по умолчанию
+    IndexedSkipList(const IndexedSkipList<T>& other, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : IndexedSkipList(resource)
+    {
+        CopyFrom(other);
+    }
+    IndexedSkipList(IndexedSkipList<T>&& other) noexcept
+        : level(1), tail(nullptr), length(0), randomState(other.randomState), resource(other.resource)
+    {
+        StealFrom(other);
+    }
+    ~IndexedSkipList()
+    {
+        Clear();
+    }
+    IndexedSkipList<T>& operator=(const IndexedSkipList<T>& other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            CopyFrom(other);
+        }
+        return *this;
+    }
+    // Узлы забираются, только если источники памяти совпадают
+    IndexedSkipList<T>& operator=(IndexedSkipList<T>&& other)
+    {
+        if (this != &other && other.resource != resource)
+        {
+            Clear();
+            CopyFrom(other);
+            other.Clear();
+        }
+        else if (this != &other)
+        {
+            Clear();
+            StealFrom(other);
+        }
+        return *this;
+    }
+
+    T& operator[](std::int64_t index)
+    {
+        return Get(index);
+    }
+    const T& operator[](std::int64_t index) const
+    {
+        return Get(index);
+    }
+    T& Get(std::int64_t index)
+    {
+        if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
+        return FindNode(index)->data;
+    }
+    const T& Get(std::int64_t index) const
+    {
+        if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
+        return FindNode(index)->data;
+    }
+    T& GetFirst()
+    {
+        if (!headLinks[0].next) throw std::runtime_error("Список пуст");
+        return headLinks[0].next->data;
+    }
+    const T& GetFirst() const
+    {
+        if (!headLinks[0].next) throw std::runtime_error("Список пуст");
+        return headLinks[0].next->data;
+    }
+    T& GetLast()
+    {
+        if (!tail) throw std::runtime_error("Список пуст");
+        return tail->data;
+    }
+    const T& GetLast() const
+    {
+        if (!tail) throw std::runtime_error("Список пуст");
+        return tail->data;
+    }
+    std::int64_t GetLength() const
+    {
+        return length;
+    }
+    std::pmr::memory_resource* GetResource() const
+    {
+        return resource;
+    }
+
+    IndexedSkipList<T> GetSubList(std::int64_t startIndex, std::int64_t endIndex) const
+    {
+        if (startIndex < 0 || endIndex >= length || startIndex > endIndex) throw std::out_of_range("Invalid index range");
+        IndexedSkipList<T> sublist;
+        const Node* current = FindNode(startIndex);
+        for (std::int64_t i = startIndex; i <= endIndex; i++)
+        {
+            sublist.Append(current->data);
+            current = current->links[0].next;
+        }
+        return sublist;
+    }
+
+    void InsertAt(T item, std::int64_t index)
+    {
+        if (index < 0 || index > length) throw std::out_of_range("Index out of range");
+        Node* update[MaxLevel];
+        std::int64_t positions[MaxLevel];
+        int height = RandomHeight();
+        if (height > level)
+        {
+            for (int l = level; l < height; l++)
+            {
+                headLinks[l].next = nullptr;
+                headLinks[l].width = 0;
+            }
+            level = height;
+        }
+        FindPredecessors(index, update, positions);
+        Node* node = CreateNode(std::move(item), height);
+        for (int l = 0; l < level; l++)
+        {
+            Link& link = LinksOf(update[l])[l];
+            if (l < height)
+            {
+                node->links[l].next = link.next;
+                // Следующий узел после вставки стоит на позиции positions + width + 1
+                node->links[l].width = link.next != nullptr ? positions[l] + link.width + 1 - index : 0;
+                link.next = node;
+                link.width = index - positions[l];
+            }
+            else if (link.next != nullptr)
+            {
+                link.width++;
+            }
+        }
+        if (node->links[0].next == nullptr)
+        {
+            tail = node;
+        }
+        length++;
+    }
+    void Append(T item)
+    {
+        InsertAt(std::move(item), length);
+    }
+    void Prepend(T item)
+    {
+        InsertAt(std::move(item), 0);
+    }
+    void RemoveAt(std::int64_t index)
+    {
+        if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
+        Node* update[MaxLevel];
+        std::int64_t positions[MaxLevel];
+        FindPredecessors(index, update, positions);
+        Node* node = LinksOf(update[0])[0].next;
+        for (int l = 0; l < level; l++)
+        {
+            Link& link = LinksOf(update[l])[l];
+            if (l < node->height)
+            {
+                link.width = node->links[l].next != nullptr ? link.width + node->links[l].width - 1 : 0;
+                link.next = node->links[l].next;
+            }
+            else if (link.next != nullptr)
+            {
+                link.width--;
+            }
+        }
+        if (tail == node)
+        {
+            tail = update[0];
+        }
+        DestroyNode(node);
+        length--;
+        while (level > 1 && headLinks[level - 1].next == nullptr)
+        {
+            level--;
+        }
+    }
+
+    IndexedSkipList<T> Concat(const IndexedSkipList<T>& other) const
+    {
+        IndexedSkipList<T> result(*this);
+        for (const Node* current = other.headLinks[0].next; current != nullptr; current = current->links[0].next)
+        {
+            result.Append(current->data);
+        }
+        return result;
+    }
+    // Переносит элементы other в конец; other остаётся пустым
+    void Concat(IndexedSkipList<T>&& other)
+    {
+        if (this == &other || other.length == 0) return;
+        if (length == 0 && other.resource == resource)
+        {
+            StealFrom(other);
+            return;
+        }
+        for (Node* current = other.headLinks[0].next; current != nullptr; current = current->links[0].next)
+        {
+            Append(std::move(current->data));
+        }
+        other.Clear();
+    }
+
+    ConstCursor GetFirstCursor() const
+    {
+        return ConstCursor(headLinks[0].next);
+    }
+    Cursor GetFirstCursor()
+    {
+        return Cursor(headLinks[0].next, 0);
+    }
+    // Курсор на элемент index; index == GetLength() даёт позицию за концом
+    Cursor GetCursorAt(std::int64_t index)
+    {
+        if (index < 0 || index > length) throw std::out_of_range("Индекс вне диапазона");
+        if (index == length) return Cursor(nullptr, length);
+        return Cursor(FindNode(index), index);
+    }
+    // Вставляет элемент после позиции и возвращает курсор на него
+    Cursor InsertAfter(const Cursor& position, T item)
+    {
+        if (!position.node) throw std::out_of_range("Курсор вне списка");
+        InsertAt(std::move(item), position.index + 1);
+        return Cursor(position.node->links[0].next, position.index + 1);
+    }
+    // Удаляет элемент в позиции и возвращает курсор на следующий
+    Cursor Erase(const Cursor& position)
+    {
+        if (!position.node) throw std::out_of_range("Курсор вне списка");
+        Node* next = position.node->links[0].next;
+        RemoveAt(position.index);
+        return Cursor(next, position.index);
+    }
+};
+
+#endif
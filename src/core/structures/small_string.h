@@ -0,0 +1,233 @@
+#ifndef SMALL_STRING_H
+#define SMALL_STRING_H
+
+#include "DynamicArray.h"
+#include "string_compare.h"
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Неизменяемая строка-ключ с хранением коротких значений внутри объекта.
+// Строки до InlineCapacity символов не требуют выделения памяти;
+// длина хранится явно, хеш вычисляется один раз при первом запросе.
+class SmallString
+{
+public:
+    static const int InlineCapacity = 15;
+
+private:
+    union
+    {
+        char inlineChars[InlineCapacity + 1];
+        char* heapChars;
+    };
+    std::int64_t length;
+    mutable std::size_t hash;
+
+    void Assign(const char* chars, std::int64_t count)
+    {
+        if (count < 0) throw std::invalid_argument("Длина не может быть отрицательной");
+        char* target;
+        if (count <= InlineCapacity)
+        {
+            target = inlineChars;
+        }
+        else
+        {
+            heapChars = new char[count + 1];
+            target = heapChars;
+        }
+        if (count > 0)
+        {
+            std::memcpy(target, chars, count);
+        }
+        target[count] = '\0';
+        length = count;
+        hash = 0;
+    }
+
+    void Release()
+    {
+        if (!IsInline())
+        {
+            delete[] heapChars;
+        }
+        inlineChars[0] = '\0';
+        length = 0;
+        hash = 0;
+    }
+
+    void StealFrom(SmallString& other)
+    {
+        if (other.IsInline())
+        {
+            std::memcpy(inlineChars, other.inlineChars, other.length + 1);
+        }
+        else
+        {
+            heapChars = other.heapChars;
+        }
+        length = other.length;
+        hash = other.hash;
+        other.inlineChars[0] = '\0';
+        other.length = 0;
+        other.hash = 0;
+    }
+
+public:
+    SmallString() : length(0), hash(0)
+    {
+        inlineChars[0] = '\0';
+    }
+    SmallString(const char* str) : length(0), hash(0)
+    {
+        Assign(str, static_cast<std::int64_t>(std::strlen(str)));
+    }
+    SmallString(const char* chars, std::int64_t count) : length(0), hash(0)
+    {
+        Assign(chars, count);
+    }
+    SmallString(const DynamicArray<char>& arr) : length(0), hash(0)
+    {
+        Assign(arr.Data(), arr.GetSize());
+    }
+    SmallString(const ArrayView<char>& view) : length(0), hash(0)
+    {
+        Assign(view.Data(), view.GetSize());
+    }
+    SmallString(const SmallString& other) : length(0), hash(0)
+    {
+        Assign(other.Data(), other.length);
+        hash = other.hash;
+    }
+    SmallString(SmallString&& other) noexcept : length(0), hash(0)
+    {
+        StealFrom(other);
+    }
+    ~SmallString()
+    {
+        Release();
+    }
+    SmallString& operator=(const SmallString& other)
+    {
+        if (this != &other)
+        {
+            SmallString copy(other);
+            Release();
+            StealFrom(copy);
+        }
+        return *this;
+    }
+    SmallString& operator=(SmallString&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            StealFrom(other);
+        }
+        return *this;
+    }
+
+    std::int64_t GetSize() const
+    {
+        return length;
+    }
+    bool IsEmpty() const
+    {
+        return length == 0;
+    }
+    // Хранится ли строка внутри объекта без выделения памяти
+    bool IsInline() const
+    {
+        return length <= InlineCapacity;
+    }
+    // Указатель на символы, строка всегда завершается нулём
+    const char* Data() const
+    {
+        if (IsInline())
+        {
+            return inlineChars;
+        }
+        return heapChars;
+    }
+    char operator[](std::int64_t index) const
+    {
+        if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
+        return Data()[index];
+    }
+    char Get(std::int64_t index) const
+    {
+        return operator[](index);
+    }
+    // Доступ без проверки границ
+    char At(std::int64_t index) const
+    {
+        return Data()[index];
+    }
+    const char* begin() const
+    {
+        return Data();
+    }
+    const char* end() const
+    {
+        return Data() + length;
+    }
+    ArrayView<char> GetView() const
+    {
+        return ArrayView<char>(Data(), length);
+    }
+
+    // FNV-1a, кешируется в объекте
+    std::size_t GetHash() const
+    {
+        if (hash == 0)
+        {
+            std::size_t value = static_cast<std::size_t>(14695981039346656037ULL);
+            const char* chars = Data();
+            for (std::int64_t i = 0; i < length; i++)
+            {
+                value ^= static_cast<unsigned char>(chars[i]);
+                value *= static_cast<std::size_t>(1099511628211ULL);
+            }
+            if (value == 0)
+            {
+                value = 1;
+            }
+            hash = value;
+        }
+        return hash;
+    }
+
+    DynamicArray<char> ToDynamicArray() const
+    {
+        return DynamicArray<char>(Data(), length);
+    }
+    operator DynamicArray<char>() const
+    {
+        return ToDynamicArray();
+    }
+
+    // Лексикографическое сравнение: <0, 0 или >0
+    int Compare(const SmallString& other) const
+    {
+        return CompareCharRanges(Data(), length, other.Data(), other.length);
+    }
+
+    bool operator==(const SmallString& other) const
+    {
+        if (length != other.length) return false;
+        if (hash != 0 && other.hash != 0 && hash != other.hash) return false;
+        return CharRangesEqual(Data(), length, other.Data(), other.length);
+    }
+    bool operator!=(const SmallString& other) const
+    {
+        return !(*this == other);
+    }
+    bool operator<(const SmallString& other) const
+    {
+        return Compare(other) < 0;
+    }
+};
+
+#endif
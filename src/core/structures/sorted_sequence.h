@@ -5,99 +5,90 @@
 #include "Sequence.h"
 #include <functional>
 
+// Отсортированная последовательность поверх самобалансирующегося дерева.
+// Узлы хранят размеры поддеревьев, поэтому доступ по индексу и поиск позиции
+// выполняются прямо в дереве за O(log n)
 template <typename T>
 class SortedSequence : public Sequence<T> 
 {
 private:
     BinaryTree<T> tree;
-    mutable MutableArraySequence<T> cachedSequence;
-    mutable bool isCacheValid;
 
-    void rebuildCache() const 
+public:
+    using Sequence<T>::Get;
+
+    SortedSequence() 
     {
-        if (!isCacheValid) 
-        {
-            cachedSequence = MutableArraySequence<T>();
-            tree.traverseInOrder([this](const T& value) 
-            {
-                cachedSequence.Append(value);
-            });
-            isCacheValid = true;
-        }
+        tree.enableSelfBalancing();
     }
-    void ensureCacheValid() const
+    explicit SortedSequence(std::pmr::memory_resource* resource) : tree(resource) 
     {
-        if(!isCacheValid)
-        {
-            rebuildCache();
-        }
+        tree.enableSelfBalancing();
     }
 
-public:
-    SortedSequence() : isCacheValid(false) {}
-
     T GetFirst() const override 
     {
-        ensureCacheValid();
-        if (cachedSequence.GetLength() == 0) throw std::out_of_range("Sequence is empty");
-        return cachedSequence.Get(0);
+        if (tree.isEmpty()) throw std::out_of_range("Sequence is empty");
+        return tree.select(0);
     }
 
     T GetLast() const override 
     {
-        ensureCacheValid();
-        int length = cachedSequence.GetLength();
-        if (length == 0) throw std::out_of_range("Sequence is empty");
-        return cachedSequence.Get(length - 1);
+        if (tree.isEmpty()) throw std::out_of_range("Sequence is empty");
+        return tree.select(tree.size() - 1);
     }
 
-    T Get(int index) const override 
+    T Get(std::int64_t index) const override 
     {
-        ensureCacheValid();
-        return cachedSequence.Get(index);
+        return tree.select(index);
     }
 
     T Get(size_t index) const override
     {
-        ensureCacheValid();
-        return Get(static_cast<int>(index));
+        return Get(static_cast<std::int64_t>(index));
     }
 
-    int GetLength() const override 
+    std::int64_t GetLength() const override 
     {
-        ensureCacheValid();        
-        return cachedSequence.GetLength();
+        return tree.size();
     }
 
     size_t GetCount() const override 
     {
-        ensureCacheValid();        
         return static_cast<size_t>(GetLength());
     }
 
     void Add(const T& element) 
     {      
         tree.insert(element);
-        isCacheValid = false;
     }
 
-    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override 
+    Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const override 
+    {
+        if (startIndex < 0 || endIndex >= GetLength() || startIndex > endIndex) 
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        auto result = new MutableArraySequence<T>();
+        for (std::int64_t i = startIndex; i <= endIndex; i++) 
+        {
+            result->Append(tree.select(i));
+        }
+        return result;
+    }
+
+    IIterator<T>* CreateIterator() const override 
     {
-        ensureCacheValid();  
-        return cachedSequence.GetSubsequence(startIndex, endIndex);
+        return tree.CreateIterator();
     }
 
-    int IndexOf(const T& element) const 
+    std::int64_t IndexOf(const T& element) const 
     {
-        ensureCacheValid();  
-        for (int i = 0; i < cachedSequence.GetLength(); i++) 
+        if (!tree.contains(element)) 
         {
-            if (cachedSequence.Get(i) == element) 
-            {
-                return i;
-            }
+            return -1;
         }
-        return -1;
+        return tree.rank(element);
     }
 
     bool Contains(const T& element) const 
@@ -108,13 +99,11 @@ public:
     void Remove(const T& element) 
     {
         tree.remove(element);
-        isCacheValid = false;
     }
 
     void Clear() 
     {
         tree.clear();
-        isCacheValid = false;
     }
 };
 
@@ -0,0 +1,365 @@
+#ifndef SORTING_H
+#define SORTING_H
+
+#include "Sequence.h"
+#include "DynamicArray.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Сортировки над непрерывными диапазонами и последовательностями.
+// Компараторы передаются параметрами шаблона и встраиваются в код:
+// comp(a, b) возвращает true, если a должен стоять раньше b.
+//
+// IntroSort     — быстрая сортировка с медианой трёх, переходом на
+//                 пирамидальную при слишком глубокой рекурсии и на вставки
+//                 для коротких участков; O(n log n) в худшем случае, неустойчива
+// MergeSort     — устойчивая сортировка слиянием с одним буфером
+// RadixSort     — устойчивая поразрядная сортировка по целочисленному ключу
+// PartialSort   — первые k элементов в порядке сортировки, O(n log k)
+// NthElement    — k-й элемент на своём месте, слева не больше, справа не меньше
+
+namespace SortingDetail
+{
+    const std::int64_t InsertionThreshold = 16;
+
+    template <class T, class Compare>
+    void InsertionSort(T* first, T* last, Compare& comp)
+    {
+        for (T* current = first + 1; current < last; current++)
+        {
+            T value = std::move(*current);
+            T* hole = current;
+            while (hole > first && comp(value, *(hole - 1)))
+            {
+                *hole = std::move(*(hole - 1));
+                hole--;
+            }
+            *hole = std::move(value);
+        }
+    }
+
+    template <class T, class Compare>
+    void SiftDown(T* first, std::int64_t index, std::int64_t size, Compare& comp)
+    {
+        T value = std::move(first[index]);
+        while (true)
+        {
+            std::int64_t child = 2 * index + 1;
+            if (child >= size) break;
+            if (child + 1 < size && comp(first[child], first[child + 1]))
+            {
+                child++;
+            }
+            if (!comp(value, first[child])) break;
+            first[index] = std::move(first[child]);
+            index = child;
+        }
+        first[index] = std::move(value);
+    }
+
+    template <class T, class Compare>
+    void MakeHeap(T* first, std::int64_t size, Compare& comp)
+    {
+        for (std::int64_t i = size / 2 - 1; i >= 0; i--)
+        {
+            SiftDown(first, i, size, comp);
+        }
+    }
+
+    template <class T, class Compare>
+    void HeapSort(T* first, T* last, Compare& comp)
+    {
+        std::int64_t size = last - first;
+        MakeHeap(first, size, comp);
+        for (std::int64_t end = size - 1; end > 0; end--)
+        {
+            std::swap(first[0], first[end]);
+            SiftDown(first, 0, end, comp);
+        }
+    }
+
+    // Ставит медиану first, middle и last - 1 в first и делит диапазон по ней.
+    // Возвращает начало правой части
+    template <class T, class Compare>
+    T* Partition(T* first, T* last, Compare& comp)
+    {
+        T* middle = first + (last - first) / 2;
+        T* back = last - 1;
+        if (comp(*middle, *first)) std::swap(*middle, *first);
+        if (comp(*back, *middle))
+        {
+            std::swap(*back, *middle);
+            if (comp(*middle, *first)) std::swap(*middle, *first);
+        }
+        std::swap(*first, *middle);
+        const T& pivot = *first;
+        T* left = first + 1;
+        T* right = last;
+        while (true)
+        {
+            while (comp(*left, pivot)) left++;
+            right--;
+            while (comp(pivot, *right)) right--;
+            if (left >= right) return left;
+            std::swap(*left, *right);
+            left++;
+        }
+    }
+
+    template <class T, class Compare>
+    void IntroSortLoop(T* first, T* last, int depthLimit, Compare& comp)
+    {
+        while (last - first > InsertionThreshold)
+        {
+            if (depthLimit == 0)
+            {
+                HeapSort(first, last, comp);
+                return;
+            }
+            depthLimit--;
+            T* cut = Partition(first, last, comp);
+            // Рекурсия по меньшей части ограничивает глубину стека O(log n)
+            if (cut - first < last - cut)
+            {
+                IntroSortLoop(first, cut, depthLimit, comp);
+                first = cut;
+            }
+            else
+            {
+                IntroSortLoop(cut, last, depthLimit, comp);
+                last = cut;
+            }
+        }
+    }
+
+    template <class T, class Compare>
+    void MergeSortRange(T* first, T* last, T* buffer, Compare& comp)
+    {
+        std::int64_t size = last - first;
+        if (size <= InsertionThreshold)
+        {
+            InsertionSort(first, last, comp);
+            return;
+        }
+        T* middle = first + size / 2;
+        MergeSortRange(first, middle, buffer, comp);
+        MergeSortRange(middle, last, buffer, comp);
+        if (!comp(*middle, *(middle - 1))) return;
+        // Левая половина уходит в буфер и сливается обратно с правой
+        std::int64_t leftSize = middle - first;
+        std::move(first, middle, buffer);
+        T* left = buffer;
+        T* leftEnd = buffer + leftSize;
+        T* right = middle;
+        T* out = first;
+        while (left < leftEnd && right < last)
+        {
+            if (comp(*right, *left))
+            {
+                *out++ = std::move(*right++);
+            }
+            else
+            {
+                *out++ = std::move(*left++);
+            }
+        }
+        std::move(left, leftEnd, out);
+    }
+
+    inline int DepthLimit(std::int64_t size)
+    {
+        int depth = 0;
+        for (std::int64_t n = size; n > 1; n >>= 1)
+        {
+            depth++;
+        }
+        return 2 * depth;
+    }
+}
+
+template <class T, class Compare = std::less<T>>
+void IntroSort(T* first, T* last, Compare comp = Compare())
+{
+    if (last - first < 2) return;
+    SortingDetail::IntroSortLoop(first, last, SortingDetail::DepthLimit(last - first), comp);
+    SortingDetail::InsertionSort(first, last, comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void MergeSort(T* first, T* last, Compare comp = Compare())
+{
+    std::int64_t size = last - first;
+    if (size < 2) return;
+    DynamicArray<T> buffer(size / 2 + 1);
+    SortingDetail::MergeSortRange(first, last, buffer.Data(), comp);
+}
+
+// Поразрядная сортировка по ключу key(item) целого типа: по 8 бит за проход,
+// проходы по старшим разрядам, где у всех элементов один и тот же байт, пропускаются.
+// Знаковые ключи упорядочиваются с учётом знака
+template <class T, class KeyFunc>
+void RadixSort(T* first, T* last, KeyFunc key)
+{
+    using KeyType = typename std::decay<decltype(key(*first))>::type;
+    static_assert(std::is_integral<KeyType>::value, "Ключ поразрядной сортировки должен быть целым");
+    using UnsignedKey = typename std::make_unsigned<KeyType>::type;
+    const int KeyBits = static_cast<int>(sizeof(KeyType) * 8);
+    std::int64_t size = last - first;
+    if (size < 2) return;
+
+    auto bitsOf = [&key](const T& item)
+    {
+        UnsignedKey bits = static_cast<UnsignedKey>(key(item));
+        if (std::is_signed<KeyType>::value)
+        {
+            bits ^= static_cast<UnsignedKey>(UnsignedKey(1) << (sizeof(KeyType) * 8 - 1));
+        }
+        return bits;
+    };
+
+    DynamicArray<T> buffer(size);
+    T* from = first;
+    T* to = buffer.Data();
+    std::int64_t counts[256];
+    for (int shift = 0; shift < KeyBits; shift += 8)
+    {
+        std::memset(counts, 0, sizeof(counts));
+        for (std::int64_t i = 0; i < size; i++)
+        {
+            counts[(bitsOf(from[i]) >> shift) & 0xFF]++;
+        }
+        if (counts[(bitsOf(from[0]) >> shift) & 0xFF] == size) continue;
+        std::int64_t offset = 0;
+        for (int digit = 0; digit < 256; digit++)
+        {
+            std::int64_t count = counts[digit];
+            counts[digit] = offset;
+            offset += count;
+        }
+        for (std::int64_t i = 0; i < size; i++)
+        {
+            to[counts[(bitsOf(from[i]) >> shift) & 0xFF]++] = std::move(from[i]);
+        }
+        std::swap(from, to);
+    }
+    if (from != first)
+    {
+        std::move(from, from + size, first);
+    }
+}
+
+template <class T, class Compare = std::less<T>>
+void PartialSort(T* first, T* middle, T* last, Compare comp = Compare())
+{
+    std::int64_t k = middle - first;
+    if (k <= 0) return;
+    // Куча из k лучших элементов с худшим на вершине
+    SortingDetail::MakeHeap(first, k, comp);
+    for (T* current = middle; current < last; current++)
+    {
+        if (comp(*current, *first))
+        {
+            std::swap(*current, *first);
+            SortingDetail::SiftDown(first, 0, k, comp);
+        }
+    }
+    for (std::int64_t end = k - 1; end > 0; end--)
+    {
+        std::swap(first[0], first[end]);
+        SortingDetail::SiftDown(first, 0, end, comp);
+    }
+}
+
+template <class T, class Compare = std::less<T>>
+void NthElement(T* first, T* nth, T* last, Compare comp = Compare())
+{
+    if (nth < first || nth >= last) return;
+    int depthLimit = SortingDetail::DepthLimit(last - first);
+    while (last - first > SortingDetail::InsertionThreshold)
+    {
+        if (depthLimit-- == 0)
+        {
+            SortingDetail::HeapSort(first, last, comp);
+            return;
+        }
+        T* cut = SortingDetail::Partition(first, last, comp);
+        if (nth < cut)
+        {
+            last = cut;
+        }
+        else
+        {
+            first = cut;
+        }
+    }
+    SortingDetail::InsertionSort(first, last, comp);
+}
+
+// Последовательности: массивы сортируются на месте в своём буфере,
+// связные списки — перестановкой узлов
+
+template <class T, class Compare = std::less<T>>
+void Sort(MutableArraySequence<T>& sequence, Compare comp = Compare())
+{
+    IntroSort(sequence.begin(), sequence.end(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void StableSort(MutableArraySequence<T>& sequence, Compare comp = Compare())
+{
+    MergeSort(sequence.begin(), sequence.end(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void StableSort(MutableListSequence<T>& sequence, Compare comp = Compare())
+{
+    sequence.Sort(comp);
+}
+
+// Список с пропусками упорядочен по позициям, а не по значениям: значения
+// выносятся в буфер, сортируются слиянием и записываются обратно одним проходом
+template <class T, class Compare = std::less<T>>
+void StableSort(MutableListSequence<T, IndexedSkipList<T>>& sequence, Compare comp = Compare())
+{
+    DynamicArray<T> buffer;
+    buffer.Reserve(sequence.GetLength());
+    for (auto cursor = sequence.GetFirstCursor(); cursor.IsValid(); cursor.Next())
+    {
+        buffer.PushBack(std::move(cursor.Get()));
+    }
+    MergeSort(buffer.begin(), buffer.end(), comp);
+    T* item = buffer.begin();
+    for (auto cursor = sequence.GetFirstCursor(); cursor.IsValid(); cursor.Next())
+    {
+        cursor.Get() = std::move(*item++);
+    }
+}
+
+template <class T, class KeyFunc>
+void RadixSort(MutableArraySequence<T>& sequence, KeyFunc key)
+{
+    RadixSort(sequence.begin(), sequence.end(), key);
+}
+
+// Упорядочивает первые count элементов; остальные остаются в произвольном порядке
+template <class T, class Compare = std::less<T>>
+void PartialSort(MutableArraySequence<T>& sequence, std::int64_t count, Compare comp = Compare())
+{
+    if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
+    if (count > sequence.GetLength()) count = sequence.GetLength();
+    PartialSort(sequence.begin(), sequence.begin() + count, sequence.end(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void NthElement(MutableArraySequence<T>& sequence, std::int64_t index, Compare comp = Compare())
+{
+    if (index < 0 || index >= sequence.GetLength()) throw std::out_of_range("Индекс вне диапазона");
+    NthElement(sequence.begin(), sequence.begin() + index, sequence.end(), comp);
+}
+
+#endif
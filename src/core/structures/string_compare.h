@@ -0,0 +1,154 @@
+#ifndef STRING_COMPARE_H
+#define STRING_COMPARE_H
+
+#include <cstring>
+#include <cstdint>
+
+// Общие ядра сравнения строк символов для всех компараторов ключей.
+// Поиск первого несовпадения выполняется блоками по 16 (SSE2) или
+// 32 (AVX2) байта; AVX2 выбирается во время выполнения, если его
+// поддерживает процессор. Иначе используется скалярный вариант.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+    #define STRING_COMPARE_SSE2 1
+    #define STRING_COMPARE_AVX2 1
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define STRING_COMPARE_SSE2 1
+    #include <emmintrin.h>
+    #include <intrin.h>
+#endif
+
+// Индекс первого различающегося символа или length, если диапазоны совпадают
+inline std::int64_t FindMismatchScalar(const char* a, const char* b, std::int64_t length)
+{
+    std::int64_t i = 0;
+    // Сравнение словами по 8 байт, затем хвост посимвольно
+    while (i + 8 <= length)
+    {
+        unsigned long long wordA;
+        unsigned long long wordB;
+        std::memcpy(&wordA, a + i, 8);
+        std::memcpy(&wordB, b + i, 8);
+        if (wordA != wordB) break;
+        i += 8;
+    }
+    while (i < length && a[i] == b[i])
+    {
+        i++;
+    }
+    return i;
+}
+
+#ifdef STRING_COMPARE_SSE2
+inline std::int64_t FindMismatchSse2(const char* a, const char* b, std::int64_t length)
+{
+    std::int64_t i = 0;
+    while (i + 16 <= length)
+    {
+        __m128i blockA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i blockB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB))) ^ 0xFFFFu;
+        if (mask != 0)
+        {
+#ifdef _MSC_VER
+            unsigned long bit;
+            _BitScanForward(&bit, mask);
+            return i + static_cast<std::int64_t>(bit);
+#else
+            return i + __builtin_ctz(mask);
+#endif
+        }
+        i += 16;
+    }
+    return i + FindMismatchScalar(a + i, b + i, length - i);
+}
+#endif
+
+#ifdef STRING_COMPARE_AVX2
+__attribute__((target("avx2")))
+inline std::int64_t FindMismatchAvx2(const char* a, const char* b, std::int64_t length)
+{
+    std::int64_t i = 0;
+    while (i + 32 <= length)
+    {
+        __m256i blockA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i blockB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(blockA, blockB)));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+        i += 32;
+    }
+    return i + FindMismatchSse2(a + i, b + i, length - i);
+}
+
+inline bool CpuHasAvx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#else
+inline bool CpuHasAvx2()
+{
+    return false;
+}
+#endif
+
+typedef std::int64_t (*FindMismatchFunction)(const char*, const char*, std::int64_t);
+
+// Реализация выбирается один раз при первом вызове
+inline FindMismatchFunction SelectFindMismatch()
+{
+#ifdef STRING_COMPARE_AVX2
+    if (CpuHasAvx2()) return &FindMismatchAvx2;
+#endif
+#ifdef STRING_COMPARE_SSE2
+    return &FindMismatchSse2;
+#else
+    return &FindMismatchScalar;
+#endif
+}
+
+inline std::int64_t FindMismatch(const char* a, const char* b, std::int64_t length)
+{
+    // Короткие ключи дешевле сравнить без косвенного вызова
+    if (length < 16)
+    {
+        return FindMismatchScalar(a, b, length);
+    }
+    static const FindMismatchFunction implementation = SelectFindMismatch();
+    return implementation(a, b, length);
+}
+
+inline bool CharRangesEqual(const char* a, std::int64_t aLength, const char* b, std::int64_t bLength)
+{
+    if (aLength != bLength) return false;
+    return FindMismatch(a, b, aLength) == aLength;
+}
+
+// Лексикографическое сравнение (символы сравниваются как char): <0, 0 или >0
+inline int CompareCharRanges(const char* a, std::int64_t aLength, const char* b, std::int64_t bLength)
+{
+    std::int64_t minLength;
+    if (aLength < bLength)
+    {
+        minLength = aLength;
+    }
+    else
+    {
+        minLength = bLength;
+    }
+    std::int64_t mismatch = FindMismatch(a, b, minLength);
+    if (mismatch < minLength)
+    {
+        if (a[mismatch] < b[mismatch]) return -1;
+        return 1;
+    }
+    if (aLength < bLength) return -1;
+    if (bLength < aLength) return 1;
+    return 0;
+}
+
+#endif
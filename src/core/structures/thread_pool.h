@@ -0,0 +1,218 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Пул потоков с перехватом задач. У каждого рабочего потока своя очередь:
+// он берёт задачи с её конца, а простаивающий поток забирает задачи с
+// начала чужих очередей. Поток, ожидающий завершения ParallelFor, сам
+// выполняет задачи, поэтому вложенные параллельные вызовы не блокируются.
+class ThreadPool
+{
+private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> threads;
+    std::unique_ptr<WorkQueue[]> queues;
+    std::int64_t queueCount;
+    std::atomic<std::int64_t> pendingTasks;
+    std::atomic<std::int64_t> nextQueue;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    bool stopping;
+
+    // Пул и номер очереди текущего рабочего потока; -1 для внешних потоков
+    static ThreadPool*& CurrentPool()
+    {
+        static thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+    static std::int64_t& CurrentQueue()
+    {
+        static thread_local std::int64_t index = -1;
+        return index;
+    }
+
+    bool PopOwn(std::int64_t index, std::function<void()>& task)
+    {
+        WorkQueue& queue = queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool Steal(std::int64_t thief, std::function<void()>& task)
+    {
+        for (std::int64_t offset = 1; offset <= queueCount; offset++)
+        {
+            WorkQueue& queue = queues[(thief + offset) % queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void WorkerLoop(std::int64_t index)
+    {
+        CurrentPool() = this;
+        CurrentQueue() = index;
+        std::function<void()> task;
+        while (true)
+        {
+            if (PopOwn(index, task) || Steal(index, task))
+            {
+                pendingTasks--;
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, [this] { return stopping || pendingTasks.load() > 0; });
+            if (stopping && pendingTasks.load() == 0) return;
+        }
+    }
+
+public:
+    // threadCount — общее число потоков вместе с вызывающим;
+    // 0 означает число аппаратных потоков
+    explicit ThreadPool(std::int64_t threadCount = 0) : pendingTasks(0), nextQueue(0), stopping(false)
+    {
+        if (threadCount <= 0)
+        {
+            threadCount = static_cast<std::int64_t>(std::thread::hardware_concurrency());
+            if (threadCount <= 0) threadCount = 1;
+        }
+        queueCount = threadCount;
+        queues.reset(new WorkQueue[queueCount]);
+        for (std::int64_t i = 1; i < threadCount; i++)
+        {
+            threads.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Общий пул процесса, создаётся при первом обращении
+    static ThreadPool& Shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    std::int64_t GetThreadCount() const
+    {
+        return queueCount;
+    }
+
+    void Submit(std::function<void()> task)
+    {
+        std::int64_t index = CurrentPool() == this ? CurrentQueue() : nextQueue.fetch_add(1) % queueCount;
+        {
+            std::lock_guard<std::mutex> lock(queues[index].mutex);
+            queues[index].tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            pendingTasks++;
+        }
+        wakeUp.notify_one();
+    }
+
+    // Выполняет одну ожидающую задачу в текущем потоке; false, если задач нет
+    bool RunPendingTask()
+    {
+        std::int64_t index = CurrentPool() == this ? CurrentQueue() : 0;
+        std::function<void()> task;
+        if (PopOwn(index, task) || Steal(index, task))
+        {
+            pendingTasks--;
+            task();
+            return true;
+        }
+        return false;
+    }
+
+    // Вызывает body(begin, end) для блоков по grain элементов из [0, count)
+    // и возвращает управление, когда все блоки обработаны. Первое исключение
+    // из блоков передаётся вызывающему.
+    template <class Body>
+    void ParallelFor(std::int64_t count, std::int64_t grain, Body body)
+    {
+        if (count <= 0) return;
+        if (grain <= 0) throw std::invalid_argument("Размер блока должен быть положительным");
+        std::int64_t blocks = (count + grain - 1) / grain;
+        if (blocks == 1 || queueCount == 1)
+        {
+            for (std::int64_t begin = 0; begin < count; begin += grain)
+            {
+                body(begin, std::min(begin + grain, count));
+            }
+            return;
+        }
+
+        std::atomic<std::int64_t> remaining(blocks);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto runBlock = [&](std::int64_t block)
+        {
+            try
+            {
+                std::int64_t begin = block * grain;
+                body(begin, std::min(begin + grain, count));
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+            remaining--;
+        };
+        for (std::int64_t block = 1; block < blocks; block++)
+        {
+            Submit([&runBlock, block] { runBlock(block); });
+        }
+        runBlock(0);
+        while (remaining.load() > 0)
+        {
+            if (!RunPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+#endif
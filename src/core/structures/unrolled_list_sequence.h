@@ -0,0 +1,511 @@
+#ifndef UNROLLED_LIST_SEQUENCE_H
+#define UNROLLED_LIST_SEQUENCE_H
+
+#include "Sequence.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Развёрнутый список: двусвязная цепочка блоков, каждый хранит до
+// ChunkCapacity элементов подряд. Доступ по индексу проходит по блокам
+// (O(n / ChunkCapacity)), вставка и удаление сдвигают элементы только
+// внутри одного блока. Переполненный блок делится пополам; после удаления
+// недозаполненный блок занимает элемент у соседа или сливается со следующим,
+// так что все блоки, кроме последнего, заполнены не меньше чем наполовину.
+template <class T>
+class UnrolledListSequence : public Sequence<T>
+{
+public:
+    static const std::int64_t ChunkCapacity = sizeof(T) >= 64 ? 8 : 512 / static_cast<std::int64_t>(sizeof(T));
+
+private:
+    struct Chunk
+    {
+        Chunk* previous;
+        Chunk* next;
+        std::int64_t count;
+        alignas(T) unsigned char storage[sizeof(T) * ChunkCapacity];
+
+        T* Items()
+        {
+            return reinterpret_cast<T*>(storage);
+        }
+        const T* Items() const
+        {
+            return reinterpret_cast<const T*>(storage);
+        }
+    };
+
+    class UnrolledListIterator : public IIterator<T>
+    {
+    private:
+        const UnrolledListSequence<T>* sequence;
+        const Chunk* chunk;
+        std::int64_t offset;
+
+    public:
+        UnrolledListIterator(const UnrolledListSequence<T>* seq) : sequence(seq), chunk(seq->head), offset(0) {}
+
+        T GetCurrentItem() const override
+        {
+            if (chunk == nullptr)
+            {
+                throw std::out_of_range("Iterator is out of range");
+            }
+            return chunk->Items()[offset];
+        }
+
+        bool HasNext() const override
+        {
+            return chunk != nullptr;
+        }
+
+        void Next() override
+        {
+            if (chunk == nullptr) return;
+            offset++;
+            if (offset == chunk->count)
+            {
+                chunk = chunk->next;
+                offset = 0;
+            }
+        }
+
+        void Reset() override
+        {
+            chunk = sequence->head;
+            offset = 0;
+        }
+    };
+
+    Chunk* head;
+    Chunk* tail;
+    std::int64_t length;
+    std::int64_t chunkCount;
+    std::pmr::memory_resource* resource;
+
+    Chunk* CreateChunk()
+    {
+        void* memory = resource->allocate(sizeof(Chunk), alignof(Chunk));
+        Chunk* chunk = static_cast<Chunk*>(memory);
+        chunk->previous = nullptr;
+        chunk->next = nullptr;
+        chunk->count = 0;
+        chunkCount++;
+        return chunk;
+    }
+
+    void DestroyChunk(Chunk* chunk)
+    {
+        T* items = chunk->Items();
+        for (std::int64_t i = 0; i < chunk->count; i++)
+        {
+            items[i].~T();
+        }
+        resource->deallocate(chunk, sizeof(Chunk), alignof(Chunk));
+        chunkCount--;
+    }
+
+    // Вставляет пустой блок после after (или в начало, если after == nullptr)
+    Chunk* LinkChunkAfter(Chunk* after)
+    {
+        Chunk* chunk = CreateChunk();
+        chunk->previous = after;
+        if (after != nullptr)
+        {
+            chunk->next = after->next;
+            after->next = chunk;
+        }
+        else
+        {
+            chunk->next = head;
+            head = chunk;
+        }
+        if (chunk->next != nullptr)
+        {
+            chunk->next->previous = chunk;
+        }
+        else
+        {
+            tail = chunk;
+        }
+        return chunk;
+    }
+
+    void UnlinkChunk(Chunk* chunk)
+    {
+        if (chunk->previous != nullptr)
+        {
+            chunk->previous->next = chunk->next;
+        }
+        else
+        {
+            head = chunk->next;
+        }
+        if (chunk->next != nullptr)
+        {
+            chunk->next->previous = chunk->previous;
+        }
+        else
+        {
+            tail = chunk->previous;
+        }
+        DestroyChunk(chunk);
+    }
+
+    // Находит блок с элементом index; offset получает позицию внутри блока.
+    // Обход начинается с ближайшего конца списка.
+    Chunk* Locate(std::int64_t index, std::int64_t& offset) const
+    {
+        if (index < length / 2)
+        {
+            Chunk* chunk = head;
+            while (index >= chunk->count)
+            {
+                index -= chunk->count;
+                chunk = chunk->next;
+            }
+            offset = index;
+            return chunk;
+        }
+        Chunk* chunk = tail;
+        std::int64_t start = length - chunk->count;
+        while (index < start)
+        {
+            chunk = chunk->previous;
+            start -= chunk->count;
+        }
+        offset = index - start;
+        return chunk;
+    }
+
+    // Переносит вторую половину заполненного блока в новый блок после него
+    void Split(Chunk* chunk)
+    {
+        Chunk* second = LinkChunkAfter(chunk);
+        std::int64_t keep = chunk->count / 2;
+        T* from = chunk->Items();
+        T* to = second->Items();
+        for (std::int64_t i = keep; i < chunk->count; i++)
+        {
+            ::new (static_cast<void*>(to + (i - keep))) T(std::move(from[i]));
+            from[i].~T();
+        }
+        second->count = chunk->count - keep;
+        chunk->count = keep;
+    }
+
+    // Переносит все элементы next в конец chunk и удаляет next
+    void MergeWithNext(Chunk* chunk)
+    {
+        Chunk* next = chunk->next;
+        T* to = chunk->Items();
+        T* from = next->Items();
+        for (std::int64_t i = 0; i < next->count; i++)
+        {
+            ::new (static_cast<void*>(to + chunk->count + i)) T(std::move(from[i]));
+            from[i].~T();
+        }
+        chunk->count += next->count;
+        next->count = 0;
+        UnlinkChunk(next);
+    }
+
+    // Восстанавливает инвариант после удаления: каждый блок, кроме последнего,
+    // заполнен не меньше чем наполовину. Недозаполненный блок занимает элемент
+    // у соседа, который останется заполненным наполовину, иначе сливается со
+    // следующим блоком — у любого блока, кроме последнего, он есть
+    void Rebalance(Chunk* chunk)
+    {
+        const std::int64_t half = ChunkCapacity / 2;
+        if (chunk->next == nullptr || chunk->count >= half) return;
+        Chunk* next = chunk->next;
+        Chunk* previous = chunk->previous;
+        if (next->count > half)
+        {
+            T* from = next->Items();
+            ::new (static_cast<void*>(chunk->Items() + chunk->count)) T(std::move(from[0]));
+            for (std::int64_t i = 0; i < next->count - 1; i++)
+            {
+                from[i] = std::move(from[i + 1]);
+            }
+            from[next->count - 1].~T();
+            next->count--;
+            chunk->count++;
+        }
+        else if (previous != nullptr && previous->count > half)
+        {
+            T* from = previous->Items();
+            InsertIntoChunk(chunk, 0, std::move(from[previous->count - 1]));
+            from[previous->count - 1].~T();
+            previous->count--;
+        }
+        else
+        {
+            MergeWithNext(chunk);
+        }
+    }
+
+    static void InsertIntoChunk(Chunk* chunk, std::int64_t offset, T&& item)
+    {
+        T* items = chunk->Items();
+        if (offset == chunk->count)
+        {
+            ::new (static_cast<void*>(items + offset)) T(std::move(item));
+        }
+        else
+        {
+            ::new (static_cast<void*>(items + chunk->count)) T(std::move(items[chunk->count - 1]));
+            for (std::int64_t i = chunk->count - 1; i > offset; i--)
+            {
+                items[i] = std::move(items[i - 1]);
+            }
+            items[offset] = std::move(item);
+        }
+        chunk->count++;
+    }
+
+    void CopyFrom(const UnrolledListSequence<T>& other)
+    {
+        for (const Chunk* chunk = other.head; chunk != nullptr; chunk = chunk->next)
+        {
+            const T* items = chunk->Items();
+            for (std::int64_t i = 0; i < chunk->count; i++)
+            {
+                Append(items[i]);
+            }
+        }
+    }
+
+public:
+    UnrolledListSequence(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : head(nullptr), tail(nullptr), length(0), chunkCount(0), resource(resource) {}
+    UnrolledListSequence(const T* items, std::int64_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : UnrolledListSequence(resource)
+    {
+        AppendRange(items, count);
+    }
+    UnrolledListSequence(const UnrolledListSequence<T>& other)
+        : UnrolledListSequence(std::pmr::get_default_resource())
+    {
+        CopyFrom(other);
+    }
+    UnrolledListSequence(UnrolledListSequence<T>&& other) noexcept
+        : head(other.head), tail(other.tail), length(other.length), chunkCount(other.chunkCount), resource(other.resource)
+    {
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.length = 0;
+        other.chunkCount = 0;
+    }
+    ~UnrolledListSequence()
+    {
+        Clear();
+    }
+    UnrolledListSequence<T>& operator=(const UnrolledListSequence<T>& other)
+    {
+        if (this != &other)
+        {
+            UnrolledListSequence<T> copy(other, resource);
+            Clear();
+            std::swap(head, copy.head);
+            std::swap(tail, copy.tail);
+            std::swap(length, copy.length);
+            std::swap(chunkCount, copy.chunkCount);
+        }
+        return *this;
+    }
+    UnrolledListSequence(const UnrolledListSequence<T>& other, std::pmr::memory_resource* resource)
+        : UnrolledListSequence(resource)
+    {
+        CopyFrom(other);
+    }
+
+    T GetFirst() const override
+    {
+        if (length == 0) throw std::out_of_range("Последовательность пуста");
+        return head->Items()[0];
+    }
+
+    T GetLast() const override
+    {
+        if (length == 0) throw std::out_of_range("Последовательность пуста");
+        return tail->Items()[tail->count - 1];
+    }
+
+    T Get(std::int64_t index) const override
+    {
+        if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
+        std::int64_t offset;
+        Chunk* chunk = Locate(index, offset);
+        return chunk->Items()[offset];
+    }
+
+    using Sequence<T>::Get;
+
+    std::int64_t GetLength() const override
+    {
+        return length;
+    }
+
+    std::int64_t GetChunkCount() const
+    {
+        return chunkCount;
+    }
+
+    T& GetRef(std::int64_t index)
+    {
+        if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
+        std::int64_t offset;
+        Chunk* chunk = Locate(index, offset);
+        return chunk->Items()[offset];
+    }
+
+    void Set(std::int64_t index, T value)
+    {
+        GetRef(index) = std::move(value);
+    }
+
+    void Append(T item)
+    {
+        if (tail == nullptr || tail->count == ChunkCapacity)
+        {
+            LinkChunkAfter(tail);
+        }
+        ::new (static_cast<void*>(tail->Items() + tail->count)) T(std::move(item));
+        tail->count++;
+        length++;
+    }
+
+    void AppendRange(const T* items, std::int64_t count)
+    {
+        if (count < 0) throw std::invalid_argument("Количество не может быть отрицательным");
+        for (std::int64_t i = 0; i < count; i++)
+        {
+            Append(items[i]);
+        }
+    }
+
+    void Prepend(T item)
+    {
+        InsertAt(std::move(item), 0);
+    }
+
+    void InsertAt(T item, std::int64_t index)
+    {
+        if (index < 0 || index > length) throw std::out_of_range("Индекс вне диапазона");
+        if (index == length)
+        {
+            Append(std::move(item));
+            return;
+        }
+        std::int64_t offset;
+        Chunk* chunk = Locate(index, offset);
+        if (chunk->count == ChunkCapacity)
+        {
+            Split(chunk);
+            if (offset > chunk->count)
+            {
+                offset -= chunk->count;
+                chunk = chunk->next;
+            }
+        }
+        InsertIntoChunk(chunk, offset, std::move(item));
+        length++;
+    }
+
+    void RemoveAt(std::int64_t index)
+    {
+        if (index < 0 || index >= length) throw std::out_of_range("Индекс вне диапазона");
+        std::int64_t offset;
+        Chunk* chunk = Locate(index, offset);
+        T* items = chunk->Items();
+        for (std::int64_t i = offset; i < chunk->count - 1; i++)
+        {
+            items[i] = std::move(items[i + 1]);
+        }
+        items[chunk->count - 1].~T();
+        chunk->count--;
+        length--;
+        if (chunk->count == 0)
+        {
+            UnlinkChunk(chunk);
+            return;
+        }
+        Rebalance(chunk);
+    }
+
+    void Clear()
+    {
+        while (head != nullptr)
+        {
+            Chunk* next = head->next;
+            DestroyChunk(head);
+            head = next;
+        }
+        tail = nullptr;
+        length = 0;
+    }
+
+    Sequence<T>* GetSubsequence(std::int64_t startIndex, std::int64_t endIndex) const override
+    {
+        if (startIndex < 0 || endIndex >= length || startIndex > endIndex)
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        UnrolledListSequence<T>* result = new UnrolledListSequence<T>();
+        std::int64_t offset;
+        const Chunk* chunk = Locate(startIndex, offset);
+        for (std::int64_t remaining = endIndex - startIndex + 1; remaining > 0; remaining--)
+        {
+            result->Append(chunk->Items()[offset]);
+            offset++;
+            if (offset == chunk->count)
+            {
+                chunk = chunk->next;
+                offset = 0;
+            }
+        }
+        return result;
+    }
+
+    IIterator<T>* CreateIterator() const override
+    {
+        return new UnrolledListIterator(this);
+    }
+
+    void CopyTo(T* destination, std::int64_t startIndex, std::int64_t count) const override
+    {
+        if (startIndex < 0 || count < 0 || startIndex + count > length)
+        {
+            throw std::out_of_range("Неверный диапазон индексов");
+        }
+        if (count == 0) return;
+        std::int64_t offset;
+        const Chunk* chunk = Locate(startIndex, offset);
+        while (count > 0)
+        {
+            std::int64_t take = chunk->count - offset < count ? chunk->count - offset : count;
+            std::copy(chunk->Items() + offset, chunk->Items() + offset + take, destination);
+            destination += take;
+            count -= take;
+            chunk = chunk->next;
+            offset = 0;
+        }
+    }
+
+protected:
+    // Каждый блок уже непрерывен и передаётся без копирования
+    void VisitChunks(typename Sequence<T>::ChunkCallback callback, void* context) const override
+    {
+        for (const Chunk* chunk = head; chunk != nullptr; chunk = chunk->next)
+        {
+            if (!callback(context, chunk->Items(), chunk->count)) return;
+        }
+    }
+};
+
+#endif
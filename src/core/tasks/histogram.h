@@ -4,6 +4,11 @@
 #include "../structures/dictionary.h"
 #include "../structures/Sequence.h"
 #include "../structures/DynamicArray.h"
+#include "../structures/small_string.h"
+#include "../structures/parallel_algorithms.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 
 // Функция для преобразования числа в строку
 template<typename T>
@@ -38,47 +43,39 @@ DynamicArray<char> NumberToString(T value)
     }
     
     // Копируем цифры в результат
-    for (int i = 0; i < digits.GetSize(); i++) 
+    for (std::int64_t i = 0; i < digits.GetSize(); i++) 
     {
-        result.InsertAt(digits.Get(i), result.GetSize());
+        result.PushBack(digits.Get(i));
     }
     
     return result;
 }
 
 // Функция для сравнения двух строк
-bool StringsEqual(const DynamicArray<char>& str1, const DynamicArray<char>& str2) 
+inline bool StringsEqual(const DynamicArray<char>& str1, const DynamicArray<char>& str2) 
 {
-    if (str1.GetSize() != str2.GetSize()) 
-    {
-        return false;
-    }
-    
-    for (int i = 0; i < str1.GetSize(); i++) 
-    {
-        if (str1.Get(i) != str2.Get(i)) 
-        {
-            return false;
-        }
-    }
-    return true;
+    return CharRangesEqual(str1.Data(), str1.GetSize(), str2.Data(), str2.GetSize());
 }
 
-// Специализация для double
-template <typename T>
-DynamicArray<char> NumberToString<double>(double value) 
+inline bool StringsEqual(const SmallString& str1, const SmallString& str2) 
+{
+    return str1 == str2;
+}
+
+// Перегрузка для double (шаблон выше опирается на операцию %)
+inline DynamicArray<char> NumberToString(double value) 
 {
     DynamicArray<char> result;
     
     int intPart = (int)value;
     DynamicArray<char> intStr = NumberToString(intPart);
     
-    for (int i = 0; i < intStr.GetSize(); i++) 
+    for (std::int64_t i = 0; i < intStr.GetSize(); i++) 
     {
-        result.InsertAt(intStr.Get(i), result.GetSize());
+        result.PushBack(intStr.Get(i));
     }
     
-    result.InsertAt('.', result.GetSize());
+    result.PushBack('.');
     
     double fractional = value - intPart;
     if (fractional < 0) fractional = -fractional;
@@ -87,7 +84,7 @@ DynamicArray<char> NumberToString<double>(double value)
     {
         fractional *= 10;
         int digit = (int)fractional % 10;
-        result.InsertAt('0' + digit, result.GetSize());
+        result.PushBack('0' + digit);
     }
     
     return result;
@@ -98,18 +95,18 @@ struct Range
 {
     T min;
     T max;
-    DynamicArray<char> label;
+    SmallString label;
     
-    Range() : min(T()), max(T()), label(DynamicArray<char>()) {}
+    Range() : min(T()), max(T()), label() {}
     
-    Range(T minVal, T maxVal, const DynamicArray<char>& rangeLabel = DynamicArray<char>()) : min(minVal), max(maxVal), label(rangeLabel) {}
+    Range(T minVal, T maxVal, const SmallString& rangeLabel = SmallString()) : min(minVal), max(maxVal), label(rangeLabel) {}
     
     bool Contains(T value) const 
     {
         return value >= min && value <= max;
     }
     
-    DynamicArray<char> ToString() const 
+    SmallString ToString() const 
     {
         if (label.GetSize() == 0) 
         {
@@ -118,24 +115,24 @@ struct Range
             result.InsertAt('[', 0);
             
             DynamicArray<char> minStr = NumberToString(min);
-            for (int i = 0; i < minStr.GetSize(); i++) 
+            for (std::int64_t i = 0; i < minStr.GetSize(); i++) 
             {
-                result.InsertAt(minStr.Get(i), result.GetSize());
+                result.PushBack(minStr.Get(i));
             }
             
-            result.InsertAt(' ', result.GetSize());
-            result.InsertAt('-', result.GetSize());
-            result.InsertAt(' ', result.GetSize());
+            result.PushBack(' ');
+            result.PushBack('-');
+            result.PushBack(' ');
             
             DynamicArray<char> maxStr = NumberToString(max);
-            for (int i = 0; i < maxStr.GetSize(); i++) 
+            for (std::int64_t i = 0; i < maxStr.GetSize(); i++) 
             {
-                result.InsertAt(maxStr.Get(i), result.GetSize());
+                result.PushBack(maxStr.Get(i));
             }
             
-            result.InsertAt(']', result.GetSize());
+            result.PushBack(']');
             
-            return result;
+            return SmallString(result);
         }
         return label;
     }
@@ -145,23 +142,98 @@ template<typename T>
 class Histogram 
 {
 private:
-    Dictionary<DynamicArray<char>, int> counts;
+    Dictionary<SmallString, std::int64_t> counts;
     DynamicArray<Range<T>> ranges;
+    std::pmr::memory_resource* resource;
 
-    int GetMaxIntValue() const 
+    // Начиная с этой длины массивы считаются параллельно на общем пуле потоков
+    static const std::int64_t ParallelCountThreshold = 1 << 16;
+    
+    std::int64_t GetMaxCountValue() const 
+    {
+        return std::numeric_limits<std::int64_t>::max();
+    }
+    
+    // Подсчитывает попадания в каждый диапазон по его индексу
+    DynamicArray<std::int64_t> CountByRange(const Sequence<T>* sequence) const 
+    {
+        DynamicArray<std::int64_t> rangeCounts(ranges.GetSize(), resource);
+        std::int64_t* countData = rangeCounts.Data();
+        const T* values = ContiguousData(sequence);
+        std::int64_t length = sequence->GetLength();
+        if (values != nullptr && length >= ParallelCountThreshold) 
+        {
+            // Массив делится на полосы по числу потоков пула: каждая полоса
+            // считает в собственную строку таблицы, строки складываются по порядку.
+            // Размер таблицы не зависит от длины массива
+            ThreadPool& pool = ThreadPool::Shared();
+            std::int64_t rangeCount = ranges.GetSize();
+            std::int64_t stripes = std::min(pool.GetThreadCount(), (length + ParallelGrainSize - 1) / ParallelGrainSize);
+            DynamicArray<std::int64_t> stripeCounts(stripes * rangeCount, resource);
+            std::int64_t* stripeData = stripeCounts.Data();
+            pool.ParallelFor(stripes, 1, [this, values, length, stripes, stripeData, rangeCount](std::int64_t first, std::int64_t last) 
+            {
+                for (std::int64_t stripe = first; stripe < last; stripe++) 
+                {
+                    std::int64_t* row = stripeData + stripe * rangeCount;
+                    std::int64_t end = length * (stripe + 1) / stripes;
+                    for (std::int64_t i = length * stripe / stripes; i < end; i++) 
+                    {
+                        std::int64_t index = FindRangeIndex(values[i]);
+                        if (index >= 0) 
+                        {
+                            row[index]++;
+                        }
+                    }
+                }
+            });
+            for (std::int64_t stripe = 0; stripe < stripes; stripe++) 
+            {
+                for (std::int64_t i = 0; i < rangeCount; i++) 
+                {
+                    countData[i] += stripeData[stripe * rangeCount + i];
+                }
+            }
+            return rangeCounts;
+        }
+        sequence->ForEachChunk([this, countData](const T* values, std::int64_t count) 
+        {
+            for (std::int64_t i = 0; i < count; i++) 
+            {
+                std::int64_t index = FindRangeIndex(values[i]);
+                if (index >= 0) 
+                {
+                    countData[index]++;
+                }
+            }
+        });
+        return rangeCounts;
+    }
+    
+    void AddRangeCounts(Dictionary<SmallString, std::int64_t>& target, const DynamicArray<std::int64_t>& rangeCounts) const 
     {
-        return 2147483647;
+        for (std::int64_t i = 0; i < rangeCounts.GetSize(); i++) 
+        {
+            std::int64_t count = rangeCounts.At(i);
+            if (count == 0) continue;
+            
+            target.Increment(ranges.At(i).ToString(), count);
+        }
     }
 
 public:
-    Histogram() : ranges(DynamicArray<Range<T>>()) {}
+    // Словарь счётчиков и рабочие массивы берутся из resource
+    Histogram(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : counts(resource), ranges(DynamicArray<Range<T>>()), resource(resource) 
+    {
+        counts.EnableNodePool();
+    }
     
-    void CreateUniformRanges(T minVal, T maxVal, int numRanges) 
+    void CreateUniformRanges(T minVal, T maxVal, std::int64_t numRanges) 
     {
         ranges = DynamicArray<Range<T>>();
         T rangeSize = (maxVal - minVal) / numRanges;
         
-        for (int i = 0; i < numRanges; i++) 
+        for (std::int64_t i = 0; i < numRanges; i++) 
         {
             T rangeMin = minVal + i * rangeSize;
             T rangeMax;
@@ -173,7 +245,7 @@ public:
             {
                 rangeMax = rangeMin + rangeSize;
             }
-            ranges.InsertAt(Range<T>(rangeMin, rangeMax), ranges.GetSize());
+            ranges.PushBack(Range<T>(rangeMin, rangeMax));
         }
     }
     
@@ -186,54 +258,25 @@ public:
     {
         counts.Clear();
         
-        for (int i = 0; i < sequence->GetLength(); i++) 
-        {
-            T value = sequence->Get(i);
-            DynamicArray<char> rangeKey = FindRange(value);
-            if (rangeKey.GetSize() > 0) 
-            {
-                if (counts.ContainsKey(rangeKey)) 
-                {
-                    int current = counts.Get(rangeKey);
-                    counts.Remove(rangeKey);
-                    counts.Add(rangeKey, current + 1);
-                } 
-                else 
-                {
-                    counts.Add(rangeKey, 1);
-                }
-            }
-        }
+        DynamicArray<std::int64_t> rangeCounts = CountByRange(sequence);
+        AddRangeCounts(counts, rangeCounts);
     }
     
     void BuildHistogramMapReduce(const Sequence<T>* sequence) 
     {
         counts.Clear();
         
-        Dictionary<DynamicArray<char>, int> mapResults;
-        for (int i = 0; i < sequence->GetLength(); i++) 
-        {
-            T value = sequence->Get(i);
-            DynamicArray<char> rangeKey = FindRange(value);
-            if (rangeKey.GetSize() > 0) 
-            {
-                if (mapResults.ContainsKey(rangeKey)) 
-                {
-                    int current = mapResults.Get(rangeKey);
-                    mapResults.Remove(rangeKey);
-                    mapResults.Add(rangeKey, current + 1);
-                } 
-                else 
-                {
-                    mapResults.Add(rangeKey, 1);
-                }
-            }
-        }
+        // Map: значение -> индекс диапазона, счётчики копятся в плоском массиве
+        DynamicArray<std::int64_t> rangeCounts = CountByRange(sequence);
+        
+        // Reduce: счётчики диапазонов сворачиваются в словарь по меткам
+        Dictionary<SmallString, std::int64_t> mapResults(resource);
+        AddRangeCounts(mapResults, rangeCounts);
         
         counts = mapResults;
     }
     
-    const Dictionary<DynamicArray<char>, int>& GetCounts() const 
+    const Dictionary<SmallString, std::int64_t>& GetCounts() const 
     {
         return counts;
     }
@@ -243,13 +286,13 @@ public:
         std::cout << "Гистограмма:\n";
         
         auto keys = counts.GetKeys();
-        for (int i = 0; i < keys->GetLength(); i++) 
+        for (std::int64_t i = 0; i < keys->GetLength(); i++) 
         {
-            DynamicArray<char> rangeKey = keys->Get(i);
-            int count = counts.Get(rangeKey);
+            SmallString rangeKey = keys->Get(i);
+            std::int64_t count = counts.Get(rangeKey);
             
             std::cout << "Диапазон: ";
-            for (int j = 0; j < rangeKey.GetSize(); j++) 
+            for (std::int64_t j = 0; j < rangeKey.GetSize(); j++) 
             {
                 std::cout << rangeKey.Get(j);
             }
@@ -258,17 +301,29 @@ public:
         delete keys;
     }
     
-    DynamicArray<char> FindRange(T value) const 
+    SmallString FindRange(T value) const 
+    {
+        std::int64_t index = FindRangeIndex(value);
+        if (index < 0) 
+        {
+            return SmallString();
+        }
+        return ranges.At(index).ToString();
+    }
+    
+    // Индекс первого диапазона, содержащего значение, или -1
+    std::int64_t FindRangeIndex(T value) const 
     {
-        for (int i = 0; i < ranges.GetSize(); i++) 
+        const Range<T>* data = ranges.Data();
+        std::int64_t rangeCount = ranges.GetSize();
+        for (std::int64_t i = 0; i < rangeCount; i++) 
         {
-            Range<T> range = ranges.Get(i);
-            if (range.Contains(value)) 
+            if (data[i].Contains(value)) 
             {
-                return range.ToString();
+                return i;
             }
         }
-        return DynamicArray<char>();
+        return -1;
     }
     
     const DynamicArray<Range<T>>& GetRanges() const 
@@ -276,14 +331,14 @@ public:
         return ranges; 
     }
     
-    int GetTotalCount() const 
+    std::int64_t GetTotalCount() const 
     {
-        int total = 0;
+        std::int64_t total = 0;
         
         auto keys = counts.GetKeys();
-        for (int i = 0; i < keys->GetLength(); i++) 
+        for (std::int64_t i = 0; i < keys->GetLength(); i++) 
         {
-            DynamicArray<char> key = keys->Get(i);
+            SmallString key = keys->Get(i);
             total += counts.Get(key);
         }
         delete keys;
@@ -291,18 +346,18 @@ public:
         return total;
     }
     
-    DynamicArray<char> GetMostFrequentRange() const 
+    SmallString GetMostFrequentRange() const 
     {
-        if (counts.GetCount() == 0) return DynamicArray<char>();
+        if (counts.GetCount() == 0) return SmallString();
         
-        DynamicArray<char> mostFrequent;
-        int maxCount = 0;
+        SmallString mostFrequent;
+        std::int64_t maxCount = 0;
         
         auto keys = counts.GetKeys();
-        for (int i = 0; i < keys->GetLength(); i++) 
+        for (std::int64_t i = 0; i < keys->GetLength(); i++) 
         {
-            DynamicArray<char> key = keys->Get(i);
-            int count = counts.Get(key);
+            SmallString key = keys->Get(i);
+            std::int64_t count = counts.Get(key);
             if (count > maxCount) {
                 maxCount = count;
                 mostFrequent = key;
@@ -313,17 +368,17 @@ public:
         return mostFrequent;
     }
 
-    DynamicArray<char> GetLeastFrequentRange() const 
+    SmallString GetLeastFrequentRange() const 
     {
-        if (counts.GetCount() == 0) return DynamicArray<char>();
+        if (counts.GetCount() == 0) return SmallString();
         
-        DynamicArray<char> leastFrequent;
-        int minCount = GetMaxIntValue();
+        SmallString leastFrequent;
+        std::int64_t minCount = GetMaxCountValue();
         
         auto keys = counts.GetKeys();
-        for (int i = 0; i < keys->GetLength(); i++) {
-            DynamicArray<char> key = keys->Get(i);
-            int count = counts.Get(key);
+        for (std::int64_t i = 0; i < keys->GetLength(); i++) {
+            SmallString key = keys->Get(i);
+            std::int64_t count = counts.Get(key);
             if (count < minCount) {
                 minCount = count;
                 leastFrequent = key;
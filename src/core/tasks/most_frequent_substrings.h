@@ -4,102 +4,109 @@
 #include "../structures/binary_tree.h"
 #include "../structures/Sequence.h"
 #include "../structures/DynamicArray.h"
+#include "../structures/small_string.h"
+#include "../structures/sorting.h"
+#include <cstdint>
 
 class MostFrequentSubstrings 
 {
 private:
     struct SubstringCount 
     {
-        DynamicArray<char> substring;
-        int count;
+        SmallString substring;
+        std::int64_t count;
         
-        SubstringCount() : substring(DynamicArray<char>()), count(0) {}
+        SubstringCount() : substring(), count(0) {}
         
-        SubstringCount(const DynamicArray<char>& sub, int cnt = 1) : substring(sub), count(cnt) {}
+        SubstringCount(const SmallString& sub, std::int64_t cnt = 1) : substring(sub), count(cnt) {}
         
-        bool operator<(const SubstringCount& other) const 
+        // Порядок дерева: сначала по длине, затем посимвольно
+        static int Compare(const char* data, std::int64_t size, const SubstringCount& other) 
         {
-            if (substring.GetSize() != other.substring.GetSize())
-                return substring.GetSize() < other.substring.GetSize();
+            std::int64_t otherSize = other.substring.GetSize();
+            if (size != otherSize)
+                return size < otherSize ? -1 : 1;
             
-            int minSize;
-            if (substring.GetSize() < other.substring.GetSize()) 
-            {
-                minSize = substring.GetSize();
-            }
-            else 
-            {
-                minSize = other.substring.GetSize();
-            }
-            for (int i = 0; i < minSize; i++) 
-            {
-                if (substring[i] != other.substring[i]) return substring[i] < other.substring[i];
-            }
-            return substring.GetSize() < other.substring.GetSize();
+            return CompareCharRanges(data, size, other.substring.Data(), size);
+        }
+        
+        bool operator<(const SubstringCount& other) const 
+        {
+            return Compare(substring.Data(), substring.GetSize(), other) < 0;
         }
         
         bool operator==(const SubstringCount& other) const 
         {
-            if (substring.GetSize() != other.substring.GetSize())
-                return false;
-            
-            for (int i = 0; i < substring.GetSize(); i++) 
-            {
-                if (substring[i] != other.substring[i]) return false;
-            }
-            return true;
+            return substring == other.substring;
+        }
+    };
+    
+    // Сравнивает заимствованный диапазон текста с элементом дерева без построения ключа
+    struct SubstringProbeCompare 
+    {
+        int operator()(const ArrayView<char>& probe, const SubstringCount& element) const 
+        {
+            return SubstringCount::Compare(probe.Data(), probe.GetSize(), element);
         }
     };
     
     BinaryTree<SubstringCount> substringTree;
-    int totalSubstrings;
+    std::int64_t totalSubstrings;
+    std::pmr::memory_resource* resource;
     
 public:
-    MostFrequentSubstrings() : totalSubstrings(0) {}
+    // Узлы дерева и рабочие буферы берутся из resource: для одного прогона
+    // можно передать арену и освободить её целиком после анализа
+    MostFrequentSubstrings(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : substringTree(resource), totalSubstrings(0), resource(resource) 
+    {
+        substringTree.enableNodePool();
+        substringTree.enableSelfBalancing();
+    }
     
-    void FindMostFrequent(const Sequence<char>* sequence, int minLength, int maxLength) 
+    void FindMostFrequent(const Sequence<char>* sequence, std::int64_t minLength, std::int64_t maxLength) 
     {
         substringTree.clear();
         totalSubstrings = 0;
         
-        int seqLength = sequence->GetLength();
+        std::int64_t seqLength = sequence->GetLength();
+        
+        // Текст берётся одним непрерывным блоком, чтобы подстроки копировались из памяти напрямую
+        DynamicArray<char> textBuffer(0, resource);
+        const char* text;
+        if (auto arraySequence = dynamic_cast<const ImmutableArraySequence<char>*>(sequence)) 
+        {
+            text = arraySequence->Data();
+        } 
+        else if (auto sliceSequence = dynamic_cast<const SliceSequence<char>*>(sequence)) 
+        {
+            text = sliceSequence->Data();
+        } 
+        else 
+        {
+            textBuffer.Resize(seqLength);
+            sequence->CopyTo(textBuffer.Data(), 0, seqLength);
+            text = textBuffer.Data();
+        }
     
-        for (int start = 0; start < seqLength; start++) 
+        for (std::int64_t start = 0; start < seqLength; start++) 
         {
-            for (int length = minLength; length <= maxLength && start + length <= seqLength; length++) 
+            for (std::int64_t length = minLength; length <= maxLength && start + length <= seqLength; length++) 
             {
-                DynamicArray<char> substring(length);
-                for (int i = 0; i < length; i++) 
+                // Спуск идёт по диапазону текста: SmallString строится только
+                // для новой подстроки. Счётчик не участвует в сравнении, поэтому
+                // он увеличивается на месте за один спуск по дереву
+                ArrayView<char> probe(text + start, length);
+                substringTree.findOrInsertWith(probe, SubstringProbeCompare(), [&probe]() 
                 {
-                    substring.Set(i, sequence->Get(start + i));
-                }
-                
-                SubstringCount newPair(substring, 1);
-            
-                if (substringTree.contains(newPair)) 
-                {
-                    auto node = substringTree.findNode(newPair);
-                    if (node) 
-                    {
-                        SubstringCount updated = node->data;
-                        updated.count++;
-                        substringTree.remove(node->data);
-                        substringTree.insert(updated);
-                    }
-                } 
-                else 
-                {
-                    substringTree.insert(newPair);
-                }
+                    return SubstringCount(SmallString(probe.Data(), probe.GetSize()), 0);
+                }).count++;
                 
                 totalSubstrings++;
             }
         }
-        
-        substringTree.balance();
     }
     
-    Sequence<SubstringCount>* GetTopFrequent(int topCount) const 
+    Sequence<SubstringCount>* GetTopFrequent(std::int64_t topCount) const 
     {
         auto result = new MutableArraySequence<SubstringCount>();
         
@@ -114,20 +121,15 @@ public:
             allSubstrings->Append(sc);
         });
         
-        int n = allSubstrings->GetLength();
-        for (int i = 0; i < n - 1; i++) {
-            for (int j = 0; j < n - i - 1; j++) 
-            {
-                if (allSubstrings->Get(j).count < allSubstrings->Get(j + 1).count) 
-                {
-                    SubstringCount temp = allSubstrings->Get(j);
-                    allSubstrings->Set(j, allSubstrings->Get(j + 1));
-                    allSubstrings->Set(j + 1, temp);
-                }
-            }
-        }
+        // По убыванию частоты, при равенстве — в порядке обхода дерева
+        std::int64_t n = allSubstrings->GetLength();
+        PartialSort(*allSubstrings, topCount, [](const SubstringCount& a, const SubstringCount& b) 
+        {
+            if (a.count != b.count) return a.count > b.count;
+            return a < b;
+        });
         
-        for (int i = 0; i < topCount && i < n; i++) 
+        for (std::int64_t i = 0; i < topCount && i < n; i++) 
         {
             result->Append(allSubstrings->Get(i));
         }
@@ -136,7 +138,7 @@ public:
         return result;
     }
     
-    void PrintUsingIterator(int maxToShow = 10) const 
+    void PrintUsingIterator(std::int64_t maxToShow = 10) const 
     {
         if (substringTree.isEmpty()) {
             std::cout << "Дерево подстрок пусто.\n";
@@ -146,14 +148,14 @@ public:
         std::cout << "Вывод через итератор дерева (первые " << maxToShow << " записей):\n";
         
         IIterator<SubstringCount>* it = substringTree.CreateIterator();
-        int count = 0;
+        std::int64_t count = 0;
         
         while (it->HasNext() && count < maxToShow) 
         {
             SubstringCount sc = it->GetCurrentItem();
             
             std::cout << "Подстрока: \"";
-            for (int i = 0; i < sc.substring.GetSize(); i++) 
+            for (std::int64_t i = 0; i < sc.substring.GetSize(); i++) 
             {
                 std::cout << sc.substring[i];
             }
@@ -199,7 +201,7 @@ public:
             {
                 SubstringCount mostFreq = top->Get(0);
                 std::cout << "Самая частая подстрока: \"";
-                for (int i = 0; i < mostFreq.substring.GetSize(); i++) 
+                for (std::int64_t i = 0; i < mostFreq.substring.GetSize(); i++) 
                 {
                     std::cout << mostFreq.substring[i];
                 }
@@ -209,17 +211,12 @@ public:
         }
     }
     
-    int GetUniqueCount() const 
+    std::int64_t GetUniqueCount() const 
     {
-        int count = 0;
-        substringTree.traverseInOrder([&count](const SubstringCount&) 
-        {
-            count++;
-        });
-        return count;
+        return substringTree.size();
     }
 
-    int GetTotalCount() const 
+    std::int64_t GetTotalCount() const 
     {
         return totalSubstrings;
     }
@@ -232,19 +229,15 @@ public:
     
     DynamicArray<char> FromCString(const char* str) 
     {
-        int length = 0;
+        std::int64_t length = 0;
         while (str[length] != '\0') length++;
         
-        DynamicArray<char> result(length);
-        for (int i = 0; i < length; i++) {
-            result.Set(i, str[i]);
-        }
-        return result;
+        return DynamicArray<char>(str, length);
     }
     
     void PrintString(const DynamicArray<char>& arr) 
     {
-        for (int i = 0; i < arr.GetSize(); i++) {
+        for (std::int64_t i = 0; i < arr.GetSize(); i++) {
             std::cout << arr[i];
         }
     }
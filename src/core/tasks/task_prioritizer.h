@@ -5,61 +5,62 @@
 #include "../structures/Sequence.h"
 #include "../structures/priority_queue.h"
 #include "../structures/DynamicArray.h"
+#include "../structures/small_string.h"
+#include "../structures/parallel_algorithms.h"
+#include "../structures/sorting.h"
+#include <cstdint>
 
-DynamicArray<char> StringToDynamicArray(const char* str) 
+inline DynamicArray<char> StringToDynamicArray(const char* str) 
 {
-    int length = 0;
+    std::int64_t length = 0;
     while (str[length] != '\0') length++;
     
-    DynamicArray<char> result(length);
-    for (int i = 0; i < length; i++)
+    return DynamicArray<char>(str, length);
+}
+
+// Переводит список ключевых слов из DynamicArray<char> в SmallString
+inline DynamicArray<SmallString> ToKeywordArray(const DynamicArray<DynamicArray<char>>& keys) 
+{
+    DynamicArray<SmallString> result;
+    result.Reserve(keys.GetSize());
+    for (const DynamicArray<char>& key : keys) 
     {
-        result.Set(i, str[i]);
+        result.PushBack(SmallString(key));
     }
     return result;
 }
 
 struct Incident 
 {
-    DynamicArray<DynamicArray<char>> keywords;
+    DynamicArray<SmallString> keywords;
     int priority;
     
-    Incident() : priority(1), keywords(DynamicArray<DynamicArray<char>>()) {}
+    Incident() : priority(1), keywords(DynamicArray<SmallString>()) {}
     
-    Incident(const DynamicArray<DynamicArray<char>>& keys, int prio = 1) : priority(prio), keywords(keys) {}
+    Incident(const DynamicArray<SmallString>& keys, int prio = 1) : priority(prio), keywords(keys) {}
     
-    Incident(const DynamicArray<char>& singleKeyword, int prio = 1) : priority(prio) 
-    {
-        keywords = DynamicArray<DynamicArray<char>>(1);
-        keywords.Set(0, singleKeyword);
-    }
+    Incident(const DynamicArray<DynamicArray<char>>& keys, int prio = 1) : priority(prio), keywords(ToKeywordArray(keys)) {}
     
-    Incident(const char* singleKeyword, int prio = 1) : priority(prio) 
+    Incident(const SmallString& singleKeyword, int prio = 1) : priority(prio) 
     {
-        keywords = DynamicArray<DynamicArray<char>>(1);
-        keywords.Set(0, StringToDynamicArray(singleKeyword));
+        keywords.PushBack(singleKeyword);
     }
 };
 
 struct Task {
-    DynamicArray<char> name;
-    DynamicArray<DynamicArray<char>> keywords;
+    SmallString name;
+    DynamicArray<SmallString> keywords;
     int calculatedPriority;
     
-    Task() : calculatedPriority(0), name(DynamicArray<char>()), keywords(DynamicArray<DynamicArray<char>>()) {}
+    Task() : calculatedPriority(0), name(), keywords(DynamicArray<SmallString>()) {}
     
-    Task(const DynamicArray<char>& taskName, const DynamicArray<DynamicArray<char>>& keys) : name(taskName), calculatedPriority(0), keywords(keys) {}
+    Task(const SmallString& taskName, const DynamicArray<SmallString>& keys) : name(taskName), calculatedPriority(0), keywords(keys) {}
     
-    Task(const char* taskName, const DynamicArray<DynamicArray<char>>& keys): calculatedPriority(0), keywords(keys) 
-    {
-        name = StringToDynamicArray(taskName);
-    }
+    Task(const SmallString& taskName, const DynamicArray<DynamicArray<char>>& keys) : name(taskName), calculatedPriority(0), keywords(ToKeywordArray(keys)) {}
     
-    Task(const char* taskName, const char* singleKeyword) : calculatedPriority(0) 
+    Task(const SmallString& taskName, const SmallString& singleKeyword) : name(taskName), calculatedPriority(0) 
     {
-        name = StringToDynamicArray(taskName);
-        keywords = DynamicArray<DynamicArray<char>>(1);
-        keywords.Set(0, StringToDynamicArray(singleKeyword));
+        keywords.PushBack(singleKeyword);
     }
     
     bool operator<(const Task& other) const 
@@ -74,11 +75,7 @@ struct Task {
     
     bool operator==(const Task& other) const 
     {
-        if (name.GetSize() != other.name.GetSize()) return false;
-        for (int i = 0; i < name.GetSize(); i++) 
-        {
-            if (name.Get(i) != other.name.Get(i)) return false;
-        }
+        if (name != other.name) return false;
         return calculatedPriority == other.calculatedPriority;
     }
 };
@@ -86,7 +83,7 @@ struct Task {
 class TaskPrioritizer 
 {
 private:
-    Dictionary<DynamicArray<char>, int> keywordPriorities;
+    Dictionary<SmallString, int> keywordPriorities;
 
     int my_min(int a, int b) 
     {
@@ -100,59 +97,67 @@ private:
         }
     }
     
-    bool stringsEqual(const DynamicArray<char>& str1, const DynamicArray<char>& str2) const 
+    bool stringsEqual(const SmallString& str1, const SmallString& str2) const 
     {
-        if (str1.GetSize() != str2.GetSize()) return false;
-        for (int i = 0; i < str1.GetSize(); i++) 
+        return str1 == str2;
+    }
+
+    template <class Storage>
+    void AssignPriorities(MutableListSequence<Task, Storage>& tasks) const 
+    {
+        for (auto cursor = tasks.GetFirstCursor(); cursor.IsValid(); cursor.Next()) 
         {
-            if (str1.Get(i) != str2.Get(i)) return false;
+            Task& task = cursor.Get();
+            task.calculatedPriority = CalculateTaskPriority(task);
         }
-        return true;
     }
 
 public:
     TaskPrioritizer() = default;
+    explicit TaskPrioritizer(std::pmr::memory_resource* resource) : keywordPriorities(resource) {}
     
     void CalculateKeywordPriorities(const Sequence<Incident>* incidents) 
     {
         keywordPriorities.Clear();
         
-        for (int i = 0; i < incidents->GetLength(); i++) 
+        incidents->ForEachChunk([this](const Incident* chunk, std::int64_t count) 
         {
-            const Incident& incident = incidents->Get(i);
-            
-            for (int j = 0; j < incident.keywords.GetSize(); j++) 
+            for (std::int64_t i = 0; i < count; i++) 
             {
-                DynamicArray<char> keyword = incident.keywords.Get(j);
-                
-                if (keywordPriorities.ContainsKey(keyword)) 
-                {
-                    int current = keywordPriorities.Get(keyword);
-                    keywordPriorities.Remove(keyword);
-                    keywordPriorities.Add(keyword, current + incident.priority);
-                } 
-                else 
+                for (const SmallString& keyword : chunk[i].keywords) 
                 {
-                    keywordPriorities.Add(keyword, incident.priority);
+                    keywordPriorities.Increment(keyword, chunk[i].priority);
                 }
             }
-        }
+        });
     }
     
     void PrioritizeTasks(Sequence<Task>* tasks) 
     {
-        for (int i = 0; i < tasks->GetLength(); i++) 
+        // Приоритеты задач массива считаются параллельно прямо в его буфере:
+        // словарь ключевых слов при этом только читается
+        if (auto arraySeq = dynamic_cast<MutableArraySequence<Task>*>(tasks)) 
         {
-            Task task = tasks->Get(i);
-            task.calculatedPriority = CalculateTaskPriority(task);
-            
-            if (auto mutableSeq = dynamic_cast<MutableArraySequence<Task>*>(tasks)) 
-            {
-                mutableSeq->Set(i, task);
-            } else if (auto mutableListSeq = dynamic_cast<MutableListSequence<Task>*>(tasks)) 
+            Task* data = arraySeq->Data();
+            ThreadPool::Shared().ParallelFor(arraySeq->GetLength(), 256, [this, data](std::int64_t begin, std::int64_t end) 
             {
-                mutableListSeq->Set(i, task);
-            }
+                for (std::int64_t i = begin; i < end; i++) 
+                {
+                    data[i].calculatedPriority = CalculateTaskPriority(data[i]);
+                }
+            });
+            SortTasksByPriority(tasks);
+            return;
+        }
+        
+        // Списки проходятся один раз курсором, приоритет пишется прямо в узел
+        if (auto mutableListSeq = dynamic_cast<MutableListSequence<Task>*>(tasks)) 
+        {
+            AssignPriorities(*mutableListSeq);
+        } 
+        else if (auto skipListSeq = dynamic_cast<MutableListSequence<Task, IndexedSkipList<Task>>*>(tasks)) 
+        {
+            AssignPriorities(*skipListSeq);
         }
         
         SortTasksByPriority(tasks);
@@ -167,12 +172,15 @@ public:
         
         PriorityQueue<Task> resultQueue(comparator);
         
-        for (int i = 0; i < tasks->GetLength(); i++) 
+        tasks->ForEachChunk([this, &resultQueue](const Task* chunk, std::int64_t count) 
         {
-            Task task = tasks->Get(i);
-            task.calculatedPriority = CalculateTaskPriority(task);
-            resultQueue.Enqueue(task);
-        }
+            for (std::int64_t i = 0; i < count; i++) 
+            {
+                Task task = chunk[i];
+                task.calculatedPriority = CalculateTaskPriority(task);
+                resultQueue.Enqueue(task);
+            }
+        });
         
         return resultQueue;
     }
@@ -180,12 +188,11 @@ public:
     int CalculateTaskPriority(const Task& task) const 
     {
         int priority = 0;
-        for (int i = 0; i < task.keywords.GetSize(); i++) 
+        for (const SmallString& keyword : task.keywords) 
         {
-            DynamicArray<char> keyword = task.keywords.Get(i);
-            if (keywordPriorities.ContainsKey(keyword)) 
+            if (const int* keywordPriority = keywordPriorities.Find(keyword)) 
             {
-                priority += keywordPriorities.Get(keyword);
+                priority += *keywordPriority;
             }
         }
         return priority;
@@ -193,64 +200,57 @@ public:
 
     void SortTasksByPriority(Sequence<Task>* tasks) 
     {
-        // Простая пузырьковая сортировка для демонстрации
+        // Устойчиво по убыванию приоритета: задачи с равным приоритетом
+        // сохраняют исходный порядок. Неизменяемые последовательности
+        // остаются как есть
+        auto byPriority = [](const Task& a, const Task& b) 
+        {
+            return a.calculatedPriority > b.calculatedPriority;
+        };
         if (auto mutableSeq = dynamic_cast<MutableArraySequence<Task>*>(tasks)) 
         {
-            int n = mutableSeq->GetLength();
-            for (int i = 0; i < n - 1; i++) 
-            {
-                for (int j = 0; j < n - i - 1; j++) 
-                {
-                    Task task1 = mutableSeq->Get(j);
-                    Task task2 = mutableSeq->Get(j + 1);
-                    if (task1.calculatedPriority < task2.calculatedPriority) 
-                    {
-                        mutableSeq->Set(j, task2);
-                        mutableSeq->Set(j + 1, task1);
-                    }
-                }
-            }
+            StableSort(*mutableSeq, byPriority);
+        } 
+        else if (auto mutableListSeq = dynamic_cast<MutableListSequence<Task>*>(tasks)) 
+        {
+            StableSort(*mutableListSeq, byPriority);
+        }
+        else if (auto skipListSeq = dynamic_cast<MutableListSequence<Task, IndexedSkipList<Task>>*>(tasks)) 
+        {
+            StableSort(*skipListSeq, byPriority);
         }
     }
     
-    const Dictionary<DynamicArray<char>, int>& GetKeywordPriorities() const 
+    const Dictionary<SmallString, int>& GetKeywordPriorities() const 
     {
         return keywordPriorities;
     }
     
-    MutableArraySequence<DynamicArray<char>> GetTopKeywords(int count) const 
+    MutableArraySequence<SmallString> GetTopKeywords(int count) const 
     {
-        MutableArraySequence<DynamicArray<char>> result;
+        MutableArraySequence<SmallString> result;
         
-        auto allPairs = new MutableArraySequence<DictionaryPair<DynamicArray<char>, int>>();
+        auto allPairs = new MutableArraySequence<DictionaryPair<SmallString, int>>();
 
-        keywordPriorities.ForEach([allPairs](const DynamicArray<char>& key, int value) 
+        keywordPriorities.ForEach([allPairs](const SmallString& key, int value) 
         {
-            allPairs->Append(DictionaryPair<DynamicArray<char>, int>(key, value));
+            allPairs->Append(DictionaryPair<SmallString, int>(key, value));
         });
         
-        for (int i = 0; i < allPairs->GetLength() - 1; i++) 
+        // Пары приходят в порядке ключей; при равных значениях он сохраняется
+        std::int64_t n = count < 0 ? 0 : count;
+        PartialSort(*allPairs, n, [](const DictionaryPair<SmallString, int>& a, const DictionaryPair<SmallString, int>& b) 
         {
-            for (int j = 0; j < allPairs->GetLength() - i - 1; j++) 
-            {
-                auto pair1 = allPairs->Get(j);
-                auto pair2 = allPairs->Get(j + 1);
-                if (pair1.getValue() < pair2.getValue()) 
-                {
-                    DictionaryPair<DynamicArray<char>, int> temp = pair1;
-                    allPairs->Set(j, pair2);
-                    allPairs->Set(j + 1, temp);
-                }
-            }
-        }
+            if (a.getValue() != b.getValue()) return a.getValue() > b.getValue();
+            return a.getKey() < b.getKey();
+        });
         
-        int n = count;
         if (n > allPairs->GetLength()) 
         {
             n = allPairs->GetLength();
         }
         
-        for (int i = 0; i < n; i++) 
+        for (std::int64_t i = 0; i < n; i++) 
         {
             result.Append(allPairs->Get(i).getKey());
         }
@@ -263,10 +263,10 @@ public:
     {
         std::cout << "Приоритеты ключевых слов:\n";
         
-        keywordPriorities.ForEach([](const DynamicArray<char>& key, int value) 
+        keywordPriorities.ForEach([](const SmallString& key, int value) 
         {
             std::cout << "Ключ: ";
-            for (int i = 0; i < key.GetSize(); i++) 
+            for (std::int64_t i = 0; i < key.GetSize(); i++) 
             {
                 std::cout << key.Get(i);
             }
@@ -277,16 +277,20 @@ public:
     void PrintPrioritizedTasks(const Sequence<Task>* tasks) const 
     {
         std::cout << "Приоритезированные задачи:\n";
-        for (int i = 0; i < tasks->GetLength(); i++) 
+        std::int64_t number = 0;
+        tasks->ForEachChunk([&number](const Task* chunk, std::int64_t count) 
         {
-            const Task& task = tasks->Get(i);
-            std::cout << (i + 1) << ". ";
-            for (int j = 0; j < task.name.GetSize(); j++) 
+            for (std::int64_t i = 0; i < count; i++) 
             {
-                std::cout << task.name.Get(j);
+                const Task& task = chunk[i];
+                std::cout << ++number << ". ";
+                for (std::int64_t j = 0; j < task.name.GetSize(); j++) 
+                {
+                    std::cout << task.name.Get(j);
+                }
+                std::cout << " (приоритет: " << task.calculatedPriority << ")\n";
             }
-            std::cout << " (приоритет: " << task.calculatedPriority << ")\n";
-        }
+        });
     }
     
     void Clear() 
@@ -294,14 +298,14 @@ public:
         keywordPriorities.Clear();
     }
     
-    int GetKeywordCount() const 
+    std::int64_t GetKeywordCount() const 
     {
         return keywordPriorities.GetCount();
     }
     
-    int GetTotalIncidentWeight() const 
+    std::int64_t GetTotalIncidentWeight() const 
     {
-        int total = 0;
+        std::int64_t total = 0;
         
         keywordPriorities.ForEachValue([&total](int value) 
         {
@@ -311,20 +315,20 @@ public:
         return total;
     }
 
-    static DynamicArray<DynamicArray<char>> ParseKeywords(const char* keywordsStr) 
+    static DynamicArray<SmallString> ParseKeywords(const char* keywordsStr) 
     {
-        DynamicArray<DynamicArray<char>> result;
+        DynamicArray<SmallString> result;
         
-        int start = 0;
-        int length = 0;
+        std::int64_t start = 0;
+        std::int64_t length = 0;
         while (keywordsStr[length] != '\0') length++;
         
-        int currentStart = 0;
-        for (int i = 0; i <= length; i++) 
+        std::int64_t currentStart = 0;
+        for (std::int64_t i = 0; i <= length; i++) 
         {
             if (keywordsStr[i] == ',' || keywordsStr[i] == '\0') 
             {
-                int wordLength = i - currentStart;
+                std::int64_t wordLength = i - currentStart;
                 if (wordLength > 0) 
                 {
                     while (currentStart < i && (keywordsStr[currentStart] == ' ' || keywordsStr[currentStart] == '\t')) 
@@ -340,12 +344,7 @@ public:
                     
                     if (wordLength > 0) 
                     {
-                        DynamicArray<char> keyword(wordLength);
-                        for (int j = 0; j < wordLength; j++) 
-                        {
-                            keyword.Set(j, keywordsStr[currentStart + j]);
-                        }
-                        result.InsertAt(keyword, result.GetSize());
+                        result.PushBack(SmallString(keywordsStr + currentStart, wordLength));
                     }
                 }
                 currentStart = i + 1;
@@ -357,7 +356,7 @@ public:
     
     static void PrintDynamicArray(const DynamicArray<char>& arr) 
     {
-        for (int i = 0; i < arr.GetSize(); i++) 
+        for (std::int64_t i = 0; i < arr.GetSize(); i++) 
         {
             std::cout << arr.Get(i);
         }
@@ -18,6 +18,7 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <cstdint>
 
 #include "core/tasks/histogram.h"
 #include "core/tasks/task_prioritizer.h"
@@ -48,11 +49,7 @@ wxString StringToWxString(const std::string& str) {
 }
 
 DynamicArray<char> StringToDynamicArray(const std::string& str) {
-    DynamicArray<char> result(static_cast<int>(str.length()));
-    for (size_t i = 0; i < str.length(); i++) {
-        result.Set(static_cast<int>(i), str[i]);
-    }
-    return result;
+    return DynamicArray<char>(str.data(), static_cast<std::int64_t>(str.length()));
 }
 
 std::string DynamicArrayToString(const DynamicArray<char>& arr) {
@@ -63,6 +60,10 @@ std::string DynamicArrayToString(const DynamicArray<char>& arr) {
     return result;
 }
 
+std::string SmallStringToString(const SmallString& str) {
+    return std::string(str.Data(), str.GetSize());
+}
+
 DynamicArray<DynamicArray<char>> StringVectorToDynamicArray(const std::vector<std::string>& vec) {
     DynamicArray<DynamicArray<char>> result(vec.size());
     for (size_t i = 0; i < vec.size(); i++) {
@@ -534,10 +535,7 @@ wxPanel* MainWindow::CreateFileAnalysisPanel(wxWindow* parent) {
             MostFrequentSubstrings fileAnalyzer;
             
             // Создание MutableArraySequence<char> для файла
-            auto sequence = new MutableArraySequence<char>(static_cast<int>(fileContent.length()));
-            for (size_t i = 0; i < fileContent.length(); i++) {
-                sequence->Set(static_cast<int>(i), fileContent[i]);
-            }
+            auto sequence = new MutableArraySequence<char>(fileContent.data(), static_cast<std::int64_t>(fileContent.length()));
             
             // Поиск подстрок
             fileAnalyzer.FindMostFrequent(sequence, minLength, maxLength);
@@ -551,24 +549,23 @@ wxPanel* MainWindow::CreateFileAnalysisPanel(wxWindow* parent) {
             for (int i = 0; i < topSubstrings->GetLength(); i++) {
                 auto sc = topSubstrings->Get(i);
                 
-                // Преобразование DynamicArray<char> в строку
-                std::string substrStr = DynamicArrayToString(sc.substring);
+                std::string substrStr = SmallStringToString(sc.substring);
                 
                 double percent = (sc.count * 100.0) / fileAnalyzer.GetTotalCount();
                 
                 long index = fileResultsList->InsertItem(fileResultsList->GetItemCount(), 
                                                          wxString::Format(wxT("%d"), i + 1));
                 fileResultsList->SetItem(index, 1, StringToWxString(substrStr));
-                fileResultsList->SetItem(index, 2, wxString::Format(wxT("%d"), sc.substring.GetSize()));
-                fileResultsList->SetItem(index, 3, wxString::Format(wxT("%d"), sc.count));
+                fileResultsList->SetItem(index, 2, wxString::Format(wxT("%lld"), (long long)sc.substring.GetSize()));
+                fileResultsList->SetItem(index, 3, wxString::Format(wxT("%lld"), (long long)sc.count));
                 fileResultsList->SetItem(index, 4, wxString::Format(wxT("%.2f%%"), percent));
             }
             
             delete topSubstrings;
             delete sequence;
             
-            SetStatusText(wxString::Format(wxT("Файл проанализирован. Найдено %d уникальных подстрок"), 
-                          fileAnalyzer.GetUniqueCount()), 1);
+            SetStatusText(wxString::Format(wxT("Файл проанализирован. Найдено %lld уникальных подстрок"), 
+                          (long long)fileAnalyzer.GetUniqueCount()), 1);
             
         } catch (const std::exception& e) {
             wxMessageBox(wxString(wxT("Ошибка анализа файла: ")) + e.what(), 
@@ -674,7 +671,7 @@ void MainWindow::UpdateHistogramResults() {
     histResults->DeleteAllItems();
     
     const auto& counts = histogram.GetCounts();
-    int total = histogram.GetTotalCount();
+    std::int64_t total = histogram.GetTotalCount();
     
     if (total == 0) {
         histStats->SetLabel(wxT("Статистика: нет данных"));
@@ -685,33 +682,32 @@ void MainWindow::UpdateHistogramResults() {
     auto keys = counts.GetKeys();
     
     for (int i = 0; i < keys->GetLength(); i++) {
-        // Преобразуем DynamicArray<char> в std::string
-        DynamicArray<char> rangeKey = keys->Get(i);
-        std::string rangeStr = DynamicArrayToString(rangeKey);
+        SmallString rangeKey = keys->Get(i);
+        std::string rangeStr = SmallStringToString(rangeKey);
         
-        int count = counts.Get(rangeKey);
+        std::int64_t count = counts.Get(rangeKey);
         double percent = (count * 100.0) / total;
         
         long index = histResults->InsertItem(histResults->GetItemCount(), StringToWxString(rangeStr));
-        histResults->SetItem(index, 1, wxString::Format(wxT("%d"), count));
+        histResults->SetItem(index, 1, wxString::Format(wxT("%lld"), (long long)count));
         histResults->SetItem(index, 2, wxString::Format(wxT("%.2f%%"), percent));
     }
     
     delete keys;
     
     // Обновление статистики
-    DynamicArray<char> mostFrequent = histogram.GetMostFrequentRange();
-    DynamicArray<char> leastFrequent = histogram.GetLeastFrequentRange();
+    SmallString mostFrequent = histogram.GetMostFrequentRange();
+    SmallString leastFrequent = histogram.GetLeastFrequentRange();
     
     // Преобразуем в строки для вывода
-    std::string mostFreqStr = DynamicArrayToString(mostFrequent);
-    std::string leastFreqStr = DynamicArrayToString(leastFrequent);
+    std::string mostFreqStr = SmallStringToString(mostFrequent);
+    std::string leastFreqStr = SmallStringToString(leastFrequent);
     
     wxString stats = wxString::Format(
-        wxT("Статистика: всего элементов: %d, уникальных диапазонов: %d, ")
+        wxT("Статистика: всего элементов: %lld, уникальных диапазонов: %lld, ")
         wxT("самый частый диапазон: %s, самый редкий: %s"),
-        total, 
-        counts.GetCount(),
+        (long long)total, 
+        (long long)counts.GetCount(),
         mostFreqStr.c_str(),
         leastFreqStr.c_str()
     );
@@ -841,8 +837,7 @@ void MainWindow::OnPrioritizeTasks(wxCommandEvent& event) {
         for (int i = 0; i < tasksSeq->GetLength(); i++) {
             const Task& task = tasksSeq->Get(i);
             
-            // Получаем имя задачи из DynamicArray<char>
-            std::string taskNameStr = DynamicArrayToString(task.name);
+            std::string taskNameStr = SmallStringToString(task.name);
             
             long index = prioritizedList->InsertItem(prioritizedList->GetItemCount(), 
                                                     wxString::Format(wxT("%d"), i + 1));
@@ -852,8 +847,8 @@ void MainWindow::OnPrioritizeTasks(wxCommandEvent& event) {
             // Формирование строки ключевых слов
             wxString keywords;
             for (int j = 0; j < task.keywords.GetSize(); j++) {
-                DynamicArray<char> keyword = task.keywords.Get(j);
-                keywords += StringToWxString(DynamicArrayToString(keyword));
+                const SmallString& keyword = task.keywords.Get(j);
+                keywords += StringToWxString(SmallStringToString(keyword));
                 if (j < task.keywords.GetSize() - 1) keywords += wxT(", ");
             }
             prioritizedList->SetItem(index, 3, keywords);
@@ -901,10 +896,7 @@ void MainWindow::OnFindSubstrings(wxCommandEvent& event) {
         
         // Создание MutableArraySequence<char>
         std::string inputStr = WxStringToString(input);
-        auto sequence = new MutableArraySequence<char>(static_cast<int>(inputStr.length()));
-        for (size_t i = 0; i < inputStr.length(); i++) {
-            sequence->Set(static_cast<int>(i), inputStr[i]);
-        }
+        auto sequence = new MutableArraySequence<char>(inputStr.data(), static_cast<std::int64_t>(inputStr.length()));
         
         // Поиск подстрок
         substringFinder.FindMostFrequent(sequence, minLength, maxLength);
@@ -918,16 +910,15 @@ void MainWindow::OnFindSubstrings(wxCommandEvent& event) {
         for (int i = 0; i < topSubstrings->GetLength(); i++) {
             auto sc = topSubstrings->Get(i);
             
-            // Преобразование DynamicArray<char> в строку
-            std::string substrStr = DynamicArrayToString(sc.substring);
+            std::string substrStr = SmallStringToString(sc.substring);
             
             double percent = (sc.count * 100.0) / substringFinder.GetTotalCount();
             
             long index = substringsResults->InsertItem(substringsResults->GetItemCount(), 
                                                       wxString::Format(wxT("%d"), i + 1));
             substringsResults->SetItem(index, 1, StringToWxString(substrStr));
-            substringsResults->SetItem(index, 2, wxString::Format(wxT("%d"), sc.substring.GetSize()));
-            substringsResults->SetItem(index, 3, wxString::Format(wxT("%d"), sc.count));
+            substringsResults->SetItem(index, 2, wxString::Format(wxT("%lld"), (long long)sc.substring.GetSize()));
+            substringsResults->SetItem(index, 3, wxString::Format(wxT("%lld"), (long long)sc.count));
             substringsResults->SetItem(index, 4, wxString::Format(wxT("%.2f%%"), percent));
         }
         
@@ -935,8 +926,8 @@ void MainWindow::OnFindSubstrings(wxCommandEvent& event) {
         delete sequence;
         
         // Обновление статистики в статус баре
-        SetStatusText(wxString::Format(wxT("Найдено %d уникальных подстрок"), 
-                      substringFinder.GetUniqueCount()), 1);
+        SetStatusText(wxString::Format(wxT("Найдено %lld уникальных подстрок"), 
+                      (long long)substringFinder.GetUniqueCount()), 1);
         
     } catch (const std::exception& e) {
         wxMessageBox(wxString(wxT("Ошибка поиска подстрок: ")) + e.what(), 
@@ -971,7 +962,14 @@ void MainWindow::OnAnalyzeFile(wxCommandEvent& event) {
             throw std::runtime_error("Не удалось открыть файл");
         }
         
-        fileContent = std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        // Размер известен заранее: один буфер и одно чтение
+        file.seekg(0, std::ios::end);
+        std::streamoff fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+        fileContent.assign(static_cast<size_t>(fileSize), '\0');
+        if (fileSize > 0) {
+            file.read(&fileContent[0], fileSize);
+        }
         file.close();
         
         // Отображаем содержимое файла
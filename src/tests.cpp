@@ -1,12 +1,20 @@
 #include <gtest/gtest.h>
 #include "core/structures/DynamicArray.h"
+#include "core/structures/small_string.h"
 #include "core/structures/LinkedList.h"
 #include "core/structures/Sequence.h"
 #include "core/structures/binary_tree.h"
 #include "core/structures/dictionary.h"
 #include "core/structures/set.h"
 #include "core/structures/sorted_sequence.h"
+#include "core/structures/unrolled_list_sequence.h"
+#include "core/structures/skip_list.h"
+#include "core/structures/persistent_sequence.h"
+#include "core/structures/pipeline.h"
+#include "core/structures/parallel_algorithms.h"
+#include "core/structures/sorting.h"
 #include "core/structures/priority_queue.h"
+#include "core/structures/node_pool.h"
 #include "core/tasks/histogram.h"
 #include "core/tasks/task_prioritizer.h"
 #include "core/tasks/most_frequent_substrings.h"
@@ -15,7 +23,15 @@
 #include <algorithm>
 #include <string>
 #include <map>
+#include <set>
 #include <unordered_set>
+#include <memory_resource>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <utility>
 extern "C" 
 {
     void _Exit(int status) { exit(status); }
@@ -256,6 +272,571 @@ TEST(DynamicArrayTest, LargeArrayPerformance)
     EXPECT_EQ(arr.Get(SIZE-1), (SIZE-1)*2);
 }
 
+TEST(DynamicArrayTest, PushBackGrowsGeometrically) 
+{
+    // Проверяет: Ёмкость растёт геометрически, а не на каждый элемент
+    DynamicArray<int> arr;
+    int reallocations = 0;
+    int lastCapacity = arr.GetCapacity();
+    const int SIZE = 100000;
+    
+    for (int i = 0; i < SIZE; i++) 
+    {
+        arr.PushBack(i);
+        if (arr.GetCapacity() != lastCapacity) 
+        {
+            reallocations++;
+            lastCapacity = arr.GetCapacity();
+        }
+    }
+    
+    EXPECT_EQ(arr.GetSize(), SIZE);
+    EXPECT_GE(arr.GetCapacity(), SIZE);
+    EXPECT_LT(reallocations, 32);
+    EXPECT_EQ(arr.Get(0), 0);
+    EXPECT_EQ(arr.Get(SIZE - 1), SIZE - 1);
+}
+
+TEST(DynamicArrayTest, ReserveAndShrinkToFit) 
+{
+    // Проверяет: Reserve не меняет размер, ShrinkToFit освобождает лишнюю ёмкость
+    DynamicArray<int> arr;
+    arr.Reserve(50);
+    EXPECT_EQ(arr.GetSize(), 0);
+    EXPECT_EQ(arr.GetCapacity(), 50);
+    
+    for (int i = 0; i < 10; i++) 
+    {
+        arr.PushBack(i);
+    }
+    EXPECT_EQ(arr.GetCapacity(), 50);
+    
+    arr.Reserve(20);
+    EXPECT_EQ(arr.GetCapacity(), 50);
+    
+    arr.ShrinkToFit();
+    EXPECT_EQ(arr.GetCapacity(), 10);
+    EXPECT_EQ(arr.Get(9), 9);
+    
+    EXPECT_THROW(arr.Reserve(-1), std::invalid_argument);
+}
+
+TEST(DynamicArrayTest, ResizeShrinkThenGrowResetsValues) 
+{
+    // Проверяет: После уменьшения и повторного увеличения новые ячейки обнулены
+    DynamicArray<int> arr(5);
+    for (int i = 0; i < 5; i++) 
+    {
+        arr.Set(i, i + 1);
+    }
+    
+    arr.Resize(2);
+    EXPECT_EQ(arr.GetCapacity(), 5);
+    arr.Resize(4);
+    EXPECT_EQ(arr.Get(1), 2);
+    EXPECT_EQ(arr.Get(2), 0);
+    EXPECT_EQ(arr.Get(3), 0);
+}
+
+namespace
+{
+    // Считает копирования и перемещения, чтобы проверять стоимость перевыделений
+    struct CopyCounter 
+    {
+        static int copies;
+        static int moves;
+        static int alive;
+        int value;
+        
+        CopyCounter(int v = 0) : value(v) { alive++; }
+        CopyCounter(const CopyCounter& other) : value(other.value) { copies++; alive++; }
+        CopyCounter(CopyCounter&& other) noexcept : value(other.value) { moves++; alive++; }
+        CopyCounter& operator=(const CopyCounter& other) { value = other.value; copies++; return *this; }
+        CopyCounter& operator=(CopyCounter&& other) noexcept { value = other.value; moves++; return *this; }
+        ~CopyCounter() { alive--; }
+        
+        static void ResetCounters() 
+        {
+            copies = 0;
+            moves = 0;
+        }
+    };
+    int CopyCounter::copies = 0;
+    int CopyCounter::moves = 0;
+    int CopyCounter::alive = 0;
+}
+
+TEST(DynamicArrayTest, ReallocationMovesInsteadOfCopying) 
+{
+    // Проверяет: При росте буфера элементы перемещаются, а не копируются
+    {
+        DynamicArray<CopyCounter> arr;
+        for (int i = 0; i < 1000; i++) 
+        {
+            arr.PushBack(CopyCounter(i));
+        }
+        CopyCounter::ResetCounters();
+        
+        arr.Reserve(5000);
+        arr.Resize(3000);
+        arr.InsertAt(CopyCounter(-1), 0);
+        
+        EXPECT_EQ(CopyCounter::copies, 0);
+        EXPECT_EQ(arr.GetSize(), 3001);
+        EXPECT_EQ(arr.Get(0).value, -1);
+        EXPECT_EQ(arr.Get(1000).value, 999);
+        EXPECT_EQ(arr.Get(3000).value, 0);
+    }
+    // Все сконструированные объекты уничтожены
+    EXPECT_EQ(CopyCounter::alive, 0);
+}
+
+TEST(DynamicArrayTest, ShrinkDestroysElements) 
+{
+    // Проверяет: Уменьшение размера сразу уничтожает лишние элементы
+    DynamicArray<CopyCounter> arr(10);
+    EXPECT_EQ(CopyCounter::alive, 10);
+    arr.Resize(3);
+    EXPECT_EQ(CopyCounter::alive, 3);
+    arr.ShrinkToFit();
+    EXPECT_EQ(CopyCounter::alive, 3);
+    EXPECT_EQ(arr.GetCapacity(), 3);
+}
+
+TEST(DynamicArrayTest, NestedArraysSurviveReallocation) 
+{
+    // Проверяет: Вложенные массивы сохраняют содержимое при перевыделении
+    DynamicArray<DynamicArray<char>> words;
+    for (int i = 0; i < 100; i++) 
+    {
+        DynamicArray<char> word(3);
+        word.Set(0, 'a' + i % 26);
+        word.Set(1, 'b');
+        word.Set(2, 'c');
+        words.PushBack(word);
+    }
+    words.InsertAt(DynamicArray<char>(1), 50);
+    
+    EXPECT_EQ(words.GetSize(), 101);
+    EXPECT_EQ(words.Get(50).GetSize(), 1);
+    EXPECT_EQ(words.Get(0).Get(0), 'a');
+    EXPECT_EQ(words.Get(100).Get(0), 'a' + 99 % 26);
+}
+
+TEST(DynamicArrayTest, DataPointerAndRangeFor) 
+{
+    // Проверяет: Data(), begin()/end() и непроверяемый доступ At
+    DynamicArray<int> arr;
+    for (int i = 0; i < 5; i++) 
+    {
+        arr.PushBack(i * 10);
+    }
+    
+    EXPECT_EQ(arr.Data()[2], 20);
+    EXPECT_EQ(arr.At(4), 40);
+    arr.At(0) = 7;
+    EXPECT_EQ(arr.Get(0), 7);
+    
+    int sum = 0;
+    for (int value : arr) 
+    {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 7 + 10 + 20 + 30 + 40);
+    EXPECT_EQ(arr.end() - arr.begin(), 5);
+}
+
+TEST(DynamicArrayTest, ArrayViewSubview) 
+{
+    // Проверяет: Представление ArrayView и его поддиапазоны
+    int data[] = {1, 2, 3, 4, 5, 6};
+    DynamicArray<int> arr(data, 6);
+    ArrayView<int> view = arr.GetView();
+    
+    EXPECT_EQ(view.GetSize(), 6);
+    EXPECT_EQ(view.Data(), arr.Data());
+    
+    ArrayView<int> middle = view.Subview(2, 3);
+    EXPECT_EQ(middle.GetSize(), 3);
+    EXPECT_EQ(middle[0], 3);
+    EXPECT_EQ(middle.At(2), 5);
+    EXPECT_THROW(middle[3], std::out_of_range);
+    EXPECT_THROW(view.Subview(4, 3), std::out_of_range);
+    
+    int sum = 0;
+    for (int value : middle) 
+    {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 12);
+}
+
+TEST(DynamicArrayTest, CopyOnWriteSharesUntilWrite)
+{
+    // Проверяет: Копии разделяют буфер до первой записи
+    CopyOnWriteStats::Reset();
+    int data[] = {1, 2, 3};
+    DynamicArray<int> original(data, 3);
+    original.EnableCopyOnWrite();
+
+    DynamicArray<int> copy = original;
+    const DynamicArray<int>& constCopy = copy;
+    const DynamicArray<int>& constOriginal = original;
+    EXPECT_TRUE(copy.IsShared());
+    EXPECT_EQ(constCopy.Data(), constOriginal.Data());
+    EXPECT_EQ(constCopy.Get(2), 3);
+
+    copy.Set(0, 10);
+    EXPECT_FALSE(copy.IsShared());
+    EXPECT_FALSE(original.IsShared());
+    EXPECT_NE(constCopy.Data(), constOriginal.Data());
+    EXPECT_EQ(original.Get(0), 1);
+    EXPECT_EQ(copy.Get(0), 10);
+    EXPECT_TRUE(copy.IsCopyOnWrite());
+
+    DynamicArray<int> second;
+    second.EnableCopyOnWrite();
+    second = original;
+    DynamicArray<int> third(original);
+    EXPECT_EQ(third.GetSize(), 3);
+
+    EXPECT_EQ(CopyOnWriteStats::GetSharedCopies(), 3);
+    EXPECT_EQ(CopyOnWriteStats::GetDetachedCopies(), 1);
+    EXPECT_EQ(CopyOnWriteStats::GetAvoidedCopies(), 2);
+}
+
+TEST(DynamicArrayTest, AssignmentKeepsCopyOnWriteMode)
+{
+    // Проверяет: Присваивание не меняет режим копирования при записи у цели
+    int data[] = {1, 2, 3};
+    DynamicArray<int> plain(data, 3);
+    DynamicArray<int> shared(data, 3);
+    shared.EnableCopyOnWrite();
+
+    DynamicArray<int> target;
+    target.EnableCopyOnWrite();
+    target = plain;
+    EXPECT_TRUE(target.IsCopyOnWrite());
+    DynamicArray<int> copy(target);
+    EXPECT_TRUE(copy.IsShared());
+    EXPECT_EQ(static_cast<const DynamicArray<int>&>(copy).Data(), static_cast<const DynamicArray<int>&>(target).Data());
+
+    DynamicArray<int> moved;
+    moved.EnableCopyOnWrite();
+    moved = DynamicArray<int>(data, 3);
+    EXPECT_TRUE(moved.IsCopyOnWrite());
+    DynamicArray<int> movedCopy(moved);
+    EXPECT_TRUE(movedCopy.IsShared());
+
+    // Массив без режима остаётся без него и не разделяет чужой буфер
+    DynamicArray<int> plainTarget;
+    plainTarget = shared;
+    EXPECT_FALSE(plainTarget.IsCopyOnWrite());
+    DynamicArray<int> sharedCopy(shared);
+    plainTarget = std::move(sharedCopy);
+    EXPECT_FALSE(plainTarget.IsCopyOnWrite());
+    EXPECT_FALSE(shared.IsShared());
+    plainTarget.Set(0, 10);
+    EXPECT_EQ(shared.Get(0), 1);
+
+    std::pmr::monotonic_buffer_resource arena;
+    DynamicArray<int> other(data, 3, &arena);
+    target = std::move(other);
+    EXPECT_TRUE(target.IsCopyOnWrite());
+    target = DynamicArray<int>(data, 3, &arena);
+    EXPECT_TRUE(target.IsCopyOnWrite());
+}
+
+TEST(DynamicArrayTest, CopyOnWriteDefersElementCopies)
+{
+    // Проверяет: Элементы копируются только при записи, память освобождается один раз
+    {
+        DynamicArray<CopyCounter> arr;
+        arr.EnableCopyOnWrite();
+        for (int i = 0; i < 10; i++)
+        {
+            arr.PushBack(CopyCounter(i));
+        }
+        CopyCounter::ResetCounters();
+
+        DynamicArray<CopyCounter> first = arr;
+        DynamicArray<CopyCounter> second = first;
+        EXPECT_EQ(CopyCounter::copies, 0);
+        EXPECT_EQ(CopyCounter::alive, 10);
+
+        second.PushBack(CopyCounter(10));
+        EXPECT_EQ(CopyCounter::copies, 10);
+        EXPECT_EQ(second.GetSize(), 11);
+        EXPECT_EQ(first.GetSize(), 10);
+    }
+    EXPECT_EQ(CopyCounter::alive, 0);
+}
+
+TEST(DynamicArrayTest, CopyOnWriteIsOptIn)
+{
+    // Проверяет: Без включения режима копии остаются глубокими
+    DynamicArray<int> arr(3);
+    DynamicArray<int> copy = arr;
+    const DynamicArray<int>& constArr = arr;
+    const DynamicArray<int>& constCopy = copy;
+    EXPECT_FALSE(copy.IsCopyOnWrite());
+    EXPECT_NE(constArr.Data(), constCopy.Data());
+
+    DynamicArray<DynamicArray<int>> nested(2);
+    nested[0].EnableCopyOnWrite();
+    nested[0].PushBack(5);
+    DynamicArray<DynamicArray<int>> nestedCopy = nested;
+    nestedCopy[0].Set(0, 7);
+    EXPECT_EQ(nested[0][0], 5);
+    EXPECT_EQ(nestedCopy[0][0], 7);
+}
+
+TEST(DynamicArrayTest, RangeOperations)
+{
+    // Проверяет: Пакетные вставка, удаление и присваивание диапазонов
+    int data[] = {1, 2, 3, 4, 5};
+    int extra[] = {10, 20};
+    DynamicArray<int> arr;
+    arr.AppendRange(data, 5);
+    arr.InsertRange(extra, 2, 1);
+    int expected[] = {1, 10, 20, 2, 3, 4, 5};
+    ASSERT_EQ(arr.GetSize(), 7);
+    for (int i = 0; i < 7; i++)
+    {
+        EXPECT_EQ(arr[i], expected[i]);
+    }
+
+    arr.EraseRange(1, 3);
+    EXPECT_EQ(arr.GetSize(), 4);
+    EXPECT_EQ(arr[1], 3);
+    EXPECT_THROW(arr.EraseRange(3, 2), std::out_of_range);
+    EXPECT_THROW(arr.InsertRange(extra, 2, 5), std::out_of_range);
+
+    // Источник внутри самого массива
+    arr.AppendRange(arr.Data(), arr.GetSize());
+    EXPECT_EQ(arr.GetSize(), 8);
+    EXPECT_EQ(arr[4], 1);
+    EXPECT_EQ(arr[7], 5);
+
+    arr.AssignFrom(extra, 2);
+    EXPECT_EQ(arr.GetSize(), 2);
+    EXPECT_EQ(arr[1], 20);
+}
+
+TEST(DynamicArrayTest, RangeOperationsWithNonTrivialElements)
+{
+    // Проверяет: Пакетные операции для элементов с конструкторами
+    std::string words[] = {"a", "b", "c", "d"};
+    std::string inserted[] = {"x", "y", "z"};
+    DynamicArray<std::string> arr;
+    arr.Reserve(16);
+    arr.AppendRange(words, 4);
+    arr.InsertRange(inserted, 3, 3);
+    std::string expected[] = {"a", "b", "c", "x", "y", "z", "d"};
+    ASSERT_EQ(arr.GetSize(), 7);
+    for (int i = 0; i < 7; i++)
+    {
+        EXPECT_EQ(arr[i], expected[i]);
+    }
+
+    arr.InsertRange(inserted, 2, 0);
+    EXPECT_EQ(arr[0], "x");
+    EXPECT_EQ(arr[2], "a");
+    EXPECT_EQ(arr[8], "d");
+
+    arr.EraseRange(0, 5);
+    EXPECT_EQ(arr.GetSize(), 4);
+    EXPECT_EQ(arr[0], "x");
+    EXPECT_EQ(arr[3], "d");
+}
+
+TEST(DynamicArrayTest, AdoptsExistingBuffer)
+{
+    // Проверяет: Массив принимает во владение готовый буфер без копирования
+    std::string* buffer = DynamicArray<std::string>::AllocateBuffer(8);
+    new (buffer) std::string("first");
+    new (buffer + 1) std::string("second");
+
+    DynamicArray<std::string> arr(buffer, 2, 8);
+    EXPECT_EQ(arr.Data(), buffer);
+    EXPECT_EQ(arr.GetCapacity(), 8);
+    arr.PushBack("third");
+    EXPECT_EQ(arr.Data(), buffer);
+    EXPECT_EQ(arr[2], "third");
+
+    MutableArraySequence<std::string> seq(std::move(arr));
+    EXPECT_EQ(seq.GetLength(), 3);
+    EXPECT_EQ(seq.Data(), buffer);
+    EXPECT_EQ(arr.GetSize(), 0);
+}
+
+// 1.1. Тесты SmallString
+
+TEST(SmallStringTest, ShortStringsStayInline) 
+{
+    // Проверяет: Короткие строки хранятся внутри объекта
+    SmallString empty;
+    EXPECT_EQ(empty.GetSize(), 0);
+    EXPECT_TRUE(empty.IsInline());
+    EXPECT_STREQ(empty.Data(), "");
+    
+    SmallString word("keyword");
+    EXPECT_EQ(word.GetSize(), 7);
+    EXPECT_TRUE(word.IsInline());
+    EXPECT_EQ(word.Get(0), 'k');
+    EXPECT_STREQ(word.Data(), "keyword");
+    
+    SmallString boundary("123456789012345");
+    EXPECT_TRUE(boundary.IsInline());
+    
+    SmallString longWord("a considerably longer keyword");
+    EXPECT_FALSE(longWord.IsInline());
+    EXPECT_EQ(longWord.GetSize(), 29);
+    EXPECT_THROW(longWord.Get(29), std::out_of_range);
+}
+
+TEST(SmallStringTest, CopyAndMoveKeepContents) 
+{
+    // Проверяет: Копирование и перемещение для обоих видов хранения
+    SmallString shortStr("abc");
+    SmallString longStr("abcdefghijklmnopqrstuvwxyz");
+    
+    SmallString shortCopy(shortStr);
+    SmallString longCopy = longStr;
+    EXPECT_EQ(shortCopy, shortStr);
+    EXPECT_EQ(longCopy, longStr);
+    EXPECT_NE(longCopy.Data(), longStr.Data());
+    
+    SmallString moved(std::move(longCopy));
+    EXPECT_EQ(moved, longStr);
+    EXPECT_EQ(longCopy.GetSize(), 0);
+    
+    shortCopy = moved;
+    EXPECT_EQ(shortCopy, longStr);
+    shortCopy = shortCopy;
+    EXPECT_EQ(shortCopy, longStr);
+    moved = SmallString("x");
+    EXPECT_STREQ(moved.Data(), "x");
+}
+
+TEST(SmallStringTest, ConversionsFromDynamicArray) 
+{
+    // Проверяет: Преобразования между SmallString и DynamicArray<char>
+    char chars[] = {'h', 'e', 'l', 'l', 'o'};
+    DynamicArray<char> arr(chars, 5);
+    
+    SmallString str = arr;
+    EXPECT_EQ(str.GetSize(), 5);
+    EXPECT_EQ(str, SmallString("hello"));
+    
+    DynamicArray<char> back = str;
+    EXPECT_EQ(back.GetSize(), 5);
+    EXPECT_EQ(back.Get(4), 'o');
+    
+    SmallString fromView(arr.GetView().Subview(1, 3));
+    EXPECT_EQ(fromView, SmallString("ell"));
+}
+
+TEST(SmallStringTest, OrderingAndHash) 
+{
+    // Проверяет: Лексикографический порядок и кешированный хеш
+    EXPECT_TRUE(SmallString("abc") < SmallString("abd"));
+    EXPECT_TRUE(SmallString("ab") < SmallString("abc"));
+    EXPECT_FALSE(SmallString("abc") < SmallString("abc"));
+    EXPECT_EQ(SmallString("abc").Compare(SmallString("abc")), 0);
+    
+    SmallString a("incident");
+    SmallString b("incident");
+    EXPECT_EQ(a.GetHash(), b.GetHash());
+    EXPECT_NE(a.GetHash(), SmallString("incidenT").GetHash());
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a == SmallString("incidenT"));
+}
+
+TEST(SmallStringTest, DictionaryWithSmallStringKeys) 
+{
+    // Проверяет: Использование SmallString как ключа словаря
+    Dictionary<SmallString, int> dict;
+    dict.Add("error", 3);
+    dict.Add("timeout", 5);
+    dict.Add("a very long keyword for the heap path", 7);
+    
+    EXPECT_EQ(dict.GetCount(), 3);
+    EXPECT_EQ(dict.Get("error"), 3);
+    EXPECT_EQ(dict.Get("a very long keyword for the heap path"), 7);
+    EXPECT_FALSE(dict.ContainsKey("warning"));
+}
+
+TEST(SmallStringTest, CompareKernelsAgreeWithReference) 
+{
+    // Проверяет: Все варианты ядра сравнения находят одно и то же несовпадение
+    const int MAX_LENGTH = 100;
+    char a[MAX_LENGTH];
+    char b[MAX_LENGTH];
+    for (int i = 0; i < MAX_LENGTH; i++) 
+    {
+        a[i] = static_cast<char>('a' + i % 26);
+        b[i] = a[i];
+    }
+    
+    for (int length = 0; length <= MAX_LENGTH; length++) 
+    {
+        EXPECT_EQ(FindMismatchScalar(a, b, length), length);
+        EXPECT_EQ(FindMismatch(a, b, length), length);
+        EXPECT_TRUE(CharRangesEqual(a, length, b, length));
+        
+        for (int position = 0; position < length; position++) 
+        {
+            b[position] = static_cast<char>(-70);
+            EXPECT_EQ(FindMismatchScalar(a, b, length), position);
+            EXPECT_EQ(FindMismatch(a, b, length), position);
+#ifdef STRING_COMPARE_SSE2
+            EXPECT_EQ(FindMismatchSse2(a, b, length), position);
+#endif
+#ifdef STRING_COMPARE_AVX2
+            if (CpuHasAvx2()) 
+            {
+                EXPECT_EQ(FindMismatchAvx2(a, b, length), position);
+            }
+#endif
+            // Символы сравниваются как char, как и в прежних компараторах
+            EXPECT_EQ(CompareCharRanges(a, length, b, length) < 0, a[position] < b[position]);
+            EXPECT_FALSE(CharRangesEqual(a, length, b, length));
+            b[position] = a[position];
+        }
+    }
+    
+    EXPECT_LT(CompareCharRanges(a, 40, b, 41), 0);
+    EXPECT_GT(CompareCharRanges(a, 41, b, 40), 0);
+}
+
+TEST(SmallStringTest, LongKeysOrderedThroughKernel) 
+{
+    // Проверяет: Порядок длинных ключей в словаре
+    std::string base(60, 'x');
+    Dictionary<SmallString, int> dict;
+    for (int i = 0; i < 26; i++) 
+    {
+        std::string key = base;
+        key[55] = static_cast<char>('z' - i);
+        dict.Add(SmallString(key.c_str()), i);
+    }
+    
+    std::string previous;
+    bool ordered = true;
+    dict.ForEachKey([&previous, &ordered](const SmallString& key) 
+    {
+        std::string current(key.Data(), key.GetSize());
+        if (!previous.empty() && !(previous < current)) 
+        {
+            ordered = false;
+        }
+        previous = current;
+    });
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(dict.GetCount(), 26);
+}
+
 // 2. Тесты LinkedList
 
 TEST(LinkedListTest, EmptyList) 
@@ -513,6 +1094,202 @@ TEST(LinkedListTest, LargeLinkedList)
     EXPECT_EQ(list.Get(999), 999);
 }
 
+TEST(LinkedListTest, TailStaysValidAfterEdits)
+{
+    // Проверяет: Последний элемент отслеживается при любых изменениях
+    LinkedList<int> list;
+    list.Prepend(2);
+    EXPECT_EQ(list.GetLast(), 2);
+    list.InsertAt(3, 1);
+    EXPECT_EQ(list.GetLast(), 3);
+    list.InsertAt(1, 0);
+    EXPECT_EQ(list.GetLast(), 3);
+    list.Append(4);
+    EXPECT_EQ(list.GetLast(), 4);
+
+    LinkedList<int> copy(list);
+    copy.Append(5);
+    EXPECT_EQ(copy.GetLast(), 5);
+    EXPECT_EQ(list.GetLast(), 4);
+
+    LinkedList<int> moved(std::move(copy));
+    EXPECT_EQ(moved.GetLast(), 5);
+    EXPECT_THROW(copy.GetLast(), std::runtime_error);
+    copy.Append(9);
+    EXPECT_EQ(copy.GetFirst(), 9);
+    EXPECT_EQ(copy.GetLast(), 9);
+}
+
+TEST(LinkedListTest, ConcatByMoveSplicesNodes)
+{
+    // Проверяет: Concat с передачей владения перевешивает узлы без копирования
+    int first[] = {1, 2};
+    int second[] = {3, 4, 5};
+    LinkedList<int> list(first, 2);
+    LinkedList<int> other(second, 3);
+    const int* lastAddress = &other.GetLast();
+
+    list.Concat(std::move(other));
+    EXPECT_EQ(list.GetLength(), 5);
+    EXPECT_EQ(other.GetLength(), 0);
+    EXPECT_EQ(&list.GetLast(), lastAddress);
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(list.Get(i), i + 1);
+    }
+
+    list.Append(6);
+    EXPECT_EQ(list.GetLast(), 6);
+
+    LinkedList<int> empty;
+    empty.Concat(std::move(list));
+    EXPECT_EQ(empty.GetFirst(), 1);
+    EXPECT_EQ(empty.GetLast(), 6);
+
+    MutableListSequence<int> seqA(first, 2);
+    MutableListSequence<int> seqB(second, 3);
+    seqA.Concat(std::move(seqB));
+    EXPECT_EQ(seqA.GetLength(), 5);
+    EXPECT_EQ(seqA.GetLast(), 5);
+}
+
+TEST(LinkedListTest, AppendMillionNodes)
+{
+    // Проверяет: Построение списка из Append выполняется за линейное время
+    const int COUNT = 1000000;
+    MutableListSequence<int> seq;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seq.Append(i);
+    }
+    EXPECT_EQ(seq.GetLength(), COUNT);
+    EXPECT_EQ(seq.GetLast(), COUNT - 1);
+}
+
+// Замер: время построения растёт линейно вплоть до 10 млн узлов.
+// Запуск: --gtest_also_run_disabled_tests --gtest_filter=*ListConstructionScaling*
+TEST(LinkedListTest, DISABLED_ListConstructionScaling)
+{
+    double previousPerNode = 0;
+    for (int count = 10000; count <= 10000000; count *= 10)
+    {
+        auto start = std::chrono::steady_clock::now();
+        {
+            LinkedList<int> list;
+            for (int i = 0; i < count; i++)
+            {
+                list.Append(i);
+            }
+            EXPECT_EQ(list.GetLast(), count - 1);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        double perNode = elapsed.count() / count;
+        std::cout << count << " узлов: " << elapsed.count() / 1e6 << " мс, " << perNode << " нс/узел" << std::endl;
+        if (previousPerNode > 0)
+        {
+            // Квадратичный рост дал бы увеличение в 10 раз на каждом шаге
+            EXPECT_LT(perNode, previousPerNode * 4);
+        }
+        previousPerNode = perNode;
+    }
+}
+
+TEST(LinkedListTest, SkipListMatchesReference)
+{
+    // Проверяет: Случайные вставки, удаления и записи по индексу совпадают с std::vector
+    IndexedSkipList<int> list;
+    std::vector<int> reference;
+    unsigned seed = 7;
+    for (int step = 0; step < 20000; step++)
+    {
+        seed = seed * 1103515245 + 12345;
+        unsigned op = (seed >> 16) % 4;
+        std::int64_t size = static_cast<std::int64_t>(reference.size());
+        std::int64_t index = size > 0 ? static_cast<std::int64_t>(seed >> 8) % size : 0;
+        if (op <= 1 || size == 0)
+        {
+            std::int64_t position = static_cast<std::int64_t>(seed >> 4) % (size + 1);
+            list.InsertAt(step, position);
+            reference.insert(reference.begin() + position, step);
+        }
+        else if (op == 2)
+        {
+            list.RemoveAt(index);
+            reference.erase(reference.begin() + index);
+        }
+        else
+        {
+            list.Get(index) = -step;
+            reference[index] = -step;
+        }
+        ASSERT_EQ(list.GetLength(), static_cast<std::int64_t>(reference.size()));
+    }
+    for (std::size_t i = 0; i < reference.size(); i++)
+    {
+        ASSERT_EQ(list.Get(static_cast<std::int64_t>(i)), reference[i]);
+    }
+    EXPECT_EQ(list.GetFirst(), reference.front());
+    EXPECT_EQ(list.GetLast(), reference.back());
+
+    std::size_t visited = 0;
+    for (auto cursor = static_cast<const IndexedSkipList<int>&>(list).GetFirstCursor(); cursor.IsValid(); cursor.Next())
+    {
+        ASSERT_EQ(cursor.Get(), reference[visited]);
+        visited++;
+    }
+    EXPECT_EQ(visited, reference.size());
+    EXPECT_THROW(list.Get(list.GetLength()), std::out_of_range);
+    EXPECT_THROW(list.RemoveAt(-1), std::out_of_range);
+}
+
+TEST(LinkedListTest, SkipListSequencePositionalAccess)
+{
+    // Проверяет: MutableListSequence на IndexedSkipList с произвольным доступом
+    // к большой последовательности
+    const int COUNT = 200000;
+    MutableListSequence<int, IndexedSkipList<int>> seq;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seq.Append(i);
+    }
+    long long sum = 0;
+    for (int i = 0; i < COUNT; i++)
+    {
+        std::int64_t index = (static_cast<std::int64_t>(i) * 7919) % COUNT;
+        seq.Set(index, seq.Get(index) * 2);
+        sum += seq.Get(index);
+    }
+    EXPECT_EQ(sum, static_cast<long long>(COUNT) * (COUNT - 1));
+    for (int i = 0; i < 1000; i++)
+    {
+        seq.InsertAt(-1, COUNT / 2);
+    }
+    EXPECT_EQ(seq.GetLength(), COUNT + 1000);
+    EXPECT_EQ(seq.Get(COUNT / 2 - 1), (COUNT / 2 - 1) * 2);
+    EXPECT_EQ(seq.Get(COUNT / 2 + 1000), COUNT);
+
+    auto sub = seq.GetSubsequence(10, 19);
+    EXPECT_EQ(sub->GetLength(), 10);
+    EXPECT_EQ(sub->Get(9), 38);
+    delete sub;
+
+    long long visited = 0;
+    seq.ForEachChunk([&visited](const int*, std::int64_t count) { visited += count; });
+    EXPECT_EQ(visited, COUNT + 1000);
+
+    auto cursor = seq.GetCursorAt(5);
+    cursor = seq.InsertAfter(cursor, 100);
+    EXPECT_EQ(seq.Get(6), 100);
+    cursor = seq.Erase(cursor);
+    EXPECT_EQ(cursor.Get(), 12);
+
+    MutableListSequence<int, IndexedSkipList<int>> tailPart;
+    tailPart.Append(1);
+    seq.Concat(std::move(tailPart));
+    EXPECT_EQ(seq.GetLast(), 1);
+    EXPECT_EQ(tailPart.GetLength(), 0);
+}
+
 // 3. Тесты Sequence
 
 TEST(SequenceTest, ImmutableArraySequenceBasicOperations) 
@@ -711,7 +1488,216 @@ TEST(SequenceTest, ListSequenceIterator)
     delete iterator;
 }
 
-TEST(SequenceTest, SequenceGetCount) 
+TEST(SequenceTest, ListSequenceIteratorLinearTime)
+{
+    // Проверяет: Обход списка из миллиона элементов итератором за O(n)
+    const int COUNT = 1000000;
+    MutableListSequence<int> seq;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seq.Append(1);
+    }
+
+    auto iterator = seq.CreateIterator();
+    long long sum = 0;
+    while (iterator->HasNext())
+    {
+        sum += iterator->GetCurrentItem();
+        iterator->Next();
+    }
+    EXPECT_EQ(sum, COUNT);
+    EXPECT_THROW(iterator->GetCurrentItem(), std::out_of_range);
+
+    iterator->Reset();
+    EXPECT_EQ(iterator->GetCurrentItem(), 1);
+    delete iterator;
+
+    long long visited = 0;
+    seq.ForEachChunk([&visited](const int* items, std::int64_t count)
+    {
+        for (std::int64_t i = 0; i < count; i++)
+        {
+            visited += items[i];
+        }
+    });
+    EXPECT_EQ(visited, COUNT);
+}
+
+TEST(SequenceTest, ListSequenceCursorInsertAndErase)
+{
+    // Проверяет: Вставку после позиции и удаление в позиции через курсор
+    int data[] = {1, 2, 3, 4, 5};
+    MutableListSequence<int> seq(data, 5);
+
+    // Удаляем чётные и вставляем удвоенное значение после нечётных
+    auto cursor = seq.GetFirstCursor();
+    while (cursor.IsValid())
+    {
+        int value = cursor.Get();
+        if (value % 2 == 0)
+        {
+            cursor = seq.Erase(cursor);
+        }
+        else
+        {
+            cursor = seq.InsertAfter(cursor, value * 10);
+            cursor.Next();
+        }
+    }
+
+    int expected[] = {1, 10, 3, 30, 5, 50};
+    ASSERT_EQ(seq.GetLength(), 6);
+    for (int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(seq.Get(i), expected[i]);
+    }
+    EXPECT_EQ(seq.GetLast(), 50);
+
+    auto first = seq.GetFirstCursor();
+    seq.Erase(first);
+    EXPECT_EQ(seq.GetFirst(), 10);
+
+    auto last = seq.GetCursorAt(4);
+    last = seq.Erase(last);
+    EXPECT_FALSE(last.IsValid());
+    EXPECT_EQ(seq.GetLast(), 5);
+    seq.Append(7);
+    EXPECT_EQ(seq.Get(4), 7);
+
+    seq.GetCursorAt(2).Get() = 99;
+    EXPECT_EQ(seq.Get(2), 99);
+    EXPECT_THROW(seq.Erase(seq.GetCursorAt(5)), std::out_of_range);
+}
+
+TEST(SequenceTest, UnrolledListSequenceMatchesReference)
+{
+    // Проверяет: Развёрнутый список ведёт себя как массив при случайных операциях
+    UnrolledListSequence<int> seq;
+    std::vector<int> reference;
+    unsigned state = 12345;
+    for (int step = 0; step < 20000; step++)
+    {
+        state = state * 1103515245u + 12345u;
+        int operation = (state >> 16) % 4;
+        int position = reference.empty() ? 0 : static_cast<int>((state >> 8) % (reference.size() + 1));
+        if (operation < 2 || reference.empty())
+        {
+            seq.InsertAt(step, position);
+            reference.insert(reference.begin() + position, step);
+        }
+        else if (operation == 2)
+        {
+            int index = position % static_cast<int>(reference.size());
+            seq.RemoveAt(index);
+            reference.erase(reference.begin() + index);
+        }
+        else
+        {
+            seq.Append(-step);
+            reference.push_back(-step);
+        }
+    }
+
+    ASSERT_EQ(seq.GetLength(), static_cast<std::int64_t>(reference.size()));
+    for (size_t i = 0; i < reference.size(); i++)
+    {
+        EXPECT_EQ(seq.Get(static_cast<std::int64_t>(i)), reference[i]);
+    }
+    EXPECT_LT(seq.GetChunkCount(), seq.GetLength() / 8);
+
+    auto iterator = seq.CreateIterator();
+    size_t visited = 0;
+    while (iterator->HasNext())
+    {
+        EXPECT_EQ(iterator->GetCurrentItem(), reference[visited]);
+        iterator->Next();
+        visited++;
+    }
+    EXPECT_EQ(visited, reference.size());
+    delete iterator;
+}
+
+TEST(SequenceTest, UnrolledListSequenceKeepsChunksHalfFull)
+{
+    // Проверяет: После удалений все блоки, кроме последнего, заполнены
+    // не меньше чем наполовину
+    const std::int64_t COUNT = 20000;
+    const std::int64_t half = UnrolledListSequence<int>::ChunkCapacity / 2;
+    UnrolledListSequence<int> seq;
+    std::vector<int> reference;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seq.Append(i);
+        reference.push_back(i);
+    }
+    // Удаление каждого третьего элемента проредило бы каждый блок
+    for (std::int64_t i = COUNT - 1; i >= 0; i -= 3)
+    {
+        seq.RemoveAt(i);
+        reference.erase(reference.begin() + i);
+    }
+    for (int i = 0; i < 500; i++)
+    {
+        seq.RemoveAt(0);
+        reference.erase(reference.begin());
+    }
+
+    std::int64_t visited = 0;
+    std::int64_t chunks = 0;
+    bool underfilled = false;
+    seq.ForEachChunk([&](const int* items, std::int64_t count)
+    {
+        if (visited + count < seq.GetLength() && count < half) underfilled = true;
+        for (std::int64_t i = 0; i < count; i++)
+        {
+            ASSERT_EQ(items[i], reference[visited + i]);
+        }
+        visited += count;
+        chunks++;
+    });
+    EXPECT_FALSE(underfilled);
+    EXPECT_EQ(visited, static_cast<std::int64_t>(reference.size()));
+    EXPECT_EQ(chunks, seq.GetChunkCount());
+    EXPECT_LE(seq.GetChunkCount(), seq.GetLength() / half + 1);
+}
+
+TEST(SequenceTest, UnrolledListSequenceTextBuffer)
+{
+    // Проверяет: Вставки в середину текстового буфера и подпоследовательности
+    const char* text = "hello world";
+    UnrolledListSequence<char> buffer(text, 11);
+    for (int i = 0; i < 100000; i++)
+    {
+        buffer.InsertAt('-', 5);
+    }
+    EXPECT_EQ(buffer.GetLength(), 100011);
+    EXPECT_EQ(buffer.Get(4), 'o');
+    EXPECT_EQ(buffer.Get(5), '-');
+    EXPECT_EQ(buffer.Get(100005), ' ');
+    EXPECT_EQ(buffer.GetLast(), 'd');
+
+    Sequence<char>* tail = buffer.GetSubsequence(100005, 100010);
+    EXPECT_EQ(tail->GetLength(), 6);
+    EXPECT_EQ(tail->GetFirst(), ' ');
+    EXPECT_EQ(tail->Get(1), 'w');
+    delete tail;
+
+    UnrolledListSequence<std::string> words;
+    words.Append("b");
+    words.Prepend("a");
+    words.Append("d");
+    words.InsertAt("c", 2);
+    UnrolledListSequence<std::string> copy(words);
+    words.Set(0, "z");
+    words.RemoveAt(1);
+    EXPECT_EQ(copy.Get(0), "a");
+    EXPECT_EQ(copy.Get(2), "c");
+    EXPECT_EQ(words.GetLength(), 3);
+    EXPECT_EQ(words.GetFirst(), "z");
+    EXPECT_THROW(words.Get(3), std::out_of_range);
+}
+
+TEST(SequenceTest, SequenceGetCount)
 {
     // Проверяет: Метод GetCount в Sequence
     int data[] = {1, 2, 3, 4, 5};
@@ -721,35 +1707,241 @@ TEST(SequenceTest, SequenceGetCount)
     EXPECT_EQ(seq.GetLength(), 5);
 }
 
-TEST(SequenceTest, LargeMutableArraySequence) 
+TEST(SequenceTest, LargeMutableArraySequence) 
+{
+    // Проверяет: Работу с большой MutableArraySequence
+    const int SIZE = 1000;
+    MutableArraySequence<int> seq;
+    
+    for (int i = 0; i < SIZE; i++) {
+        seq.Append(i);
+    }
+    
+    EXPECT_EQ(seq.GetLength(), SIZE);
+    
+    // Проверяем что можем получить все элементы
+    for (int i = 0; i < SIZE; i++) {
+        EXPECT_EQ(seq.Get(i), i);
+    }
+    
+    // Проверяем итератор на большом наборе
+    auto iterator = seq.CreateIterator();
+    int count = 0;
+    while (iterator->HasNext()) {
+        iterator->Next();
+        count++;
+    }
+    EXPECT_EQ(count, SIZE);
+    delete iterator;
+}
+
+TEST(SequenceTest, MutableArraySequenceAppendLarge) 
+{
+    // Проверяет: Append выполняется за амортизированное O(1)
+    const int SIZE = 1000000;
+    MutableArraySequence<int> seq;
+    
+    for (int i = 0; i < SIZE; i++) 
+    {
+        seq.Append(i);
+    }
+    
+    EXPECT_EQ(seq.GetLength(), SIZE);
+    EXPECT_EQ(seq.GetFirst(), 0);
+    EXPECT_EQ(seq.GetLast(), SIZE - 1);
+}
+
+TEST(SequenceTest, MutableArraySequenceRangeOperations)
+{
+    // Проверяет: Пакетная загрузка и подпоследовательности без поэлементного копирования
+    std::string text(1 << 20, 'a');
+    text[12345] = 'b';
+    MutableArraySequence<char> seq;
+    seq.AssignFrom(text.data(), static_cast<std::int64_t>(text.size()));
+    EXPECT_EQ(seq.GetLength(), static_cast<std::int64_t>(text.size()));
+    EXPECT_EQ(seq.Get(12345), 'b');
+
+    seq.AppendRange("xyz", 3);
+    seq.EraseRange(0, 12345);
+    EXPECT_EQ(seq.GetFirst(), 'b');
+    EXPECT_EQ(seq.GetLast(), 'z');
+
+    Sequence<char>* sub = seq.GetSubsequence(0, 2);
+    EXPECT_EQ(sub->GetLength(), 3);
+    EXPECT_EQ(sub->Get(0), 'b');
+    EXPECT_EQ(sub->Get(2), 'a');
+    delete sub;
+}
+
+TEST(SequenceTest, SubsequenceSharesArrayBuffer)
+{
+    // Проверяет: Подпоследовательность массива ссылается на буфер родителя без копирования
+    // и остаётся действительной после изменения и удаления родителя
+    int data[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto parent = new MutableArraySequence<int>(data, 10);
+    CopyOnWriteStats::Reset();
+
+    Sequence<int>* immutableSub = ImmutableArraySequence<int>(data, 10).GetSubsequence(2, 5);
+    auto slice = dynamic_cast<SliceSequence<int>*>(immutableSub);
+    ASSERT_NE(slice, nullptr);
+    EXPECT_EQ(slice->GetLength(), 4);
+    EXPECT_EQ(slice->GetFirst(), 2);
+    EXPECT_EQ(slice->GetLast(), 5);
+    EXPECT_THROW(slice->Get(4), std::out_of_range);
+
+    SliceSequence<int> view(DynamicArray<int>(data, 10), 0, 10);
+    const int* before = view.Data();
+    Sequence<int>* nested = view.GetSubsequence(3, 6);
+    EXPECT_EQ(dynamic_cast<SliceSequence<int>*>(nested)->Data(), before + 3);
+    EXPECT_EQ(nested->Get(0), 3);
+
+    parent->Set(0, 100);
+    Sequence<int>* parentSub = parent->GetSubsequence(0, 1);
+    EXPECT_EQ(parentSub->Get(0), 100);
+    delete parent;
+    EXPECT_EQ(parentSub->Get(1), 1);
+    EXPECT_EQ(CopyOnWriteStats::GetDetachedCopies(), 0);
+
+    int sum = 0;
+    slice->ForEachChunk([&sum](const int* items, std::int64_t count)
+    {
+        for (std::int64_t i = 0; i < count; i++)
+        {
+            sum += items[i];
+        }
+    });
+    EXPECT_EQ(sum, 2 + 3 + 4 + 5);
+
+    delete parentSub;
+    delete nested;
+    delete immutableSub;
+}
+
+TEST(SequenceTest, ArraySequenceSharesOnlyForSlices)
+{
+    // Проверяет: Копирование при записи включается только при создании среза
+    int data[] = {1, 2, 3, 4};
+    CopyOnWriteStats::Reset();
+    ImmutableArraySequence<int> original(data, 4);
+    ImmutableArraySequence<int> copy(original);
+    EXPECT_EQ(CopyOnWriteStats::GetSharedCopies(), 0);
+    EXPECT_NE(copy.Data(), original.Data());
+
+    Sequence<int>* slice = original.GetSubsequence(1, 2);
+    EXPECT_EQ(CopyOnWriteStats::GetSharedCopies(), 1);
+    EXPECT_EQ(dynamic_cast<SliceSequence<int>*>(slice)->Data(), original.Data() + 1);
+    delete slice;
+}
+
+TEST(SequenceTest, ConcurrentSlicesShareOneCounter)
+{
+    // Проверяет: Срезы константного массива из двух потоков одновременно
+    // получают общий счётчик владельцев и переживают удаление родителя
+    int data[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    for (int round = 0; round < 200; round++)
+    {
+        const ImmutableArraySequence<int>* parent = new ImmutableArraySequence<int>(data, 8);
+        std::atomic<bool> start(false);
+        Sequence<int>* slices[2] = {nullptr, nullptr};
+        auto takeSlice = [&](int slot)
+        {
+            while (!start.load())
+            {
+            }
+            slices[slot] = parent->GetSubsequence(slot, slot + 5);
+        };
+        std::thread first(takeSlice, 0);
+        std::thread second(takeSlice, 1);
+        start.store(true);
+        first.join();
+        second.join();
+
+        const int* buffer = parent->Data();
+        EXPECT_EQ(dynamic_cast<SliceSequence<int>*>(slices[0])->Data(), buffer);
+        EXPECT_EQ(dynamic_cast<SliceSequence<int>*>(slices[1])->Data(), buffer + 1);
+        delete parent;
+        EXPECT_EQ(slices[0]->Get(5), 5);
+        delete slices[0];
+        EXPECT_EQ(slices[1]->Get(5), 6);
+        delete slices[1];
+    }
+}
+
+TEST(SequenceTest, SliceIsSnapshotOfSharedBuffer)
 {
-    // Проверяет: Работу с большой MutableArraySequence
-    const int SIZE = 1000;
-    MutableArraySequence<int> seq;
-    
-    for (int i = 0; i < SIZE; i++) {
-        seq.Append(i);
+    // Проверяет: Запись в разделённый массив отделяет его копию, срез не меняется
+    DynamicArray<int> array(5);
+    for (int i = 0; i < 5; i++)
+    {
+        array[i] = i;
     }
+    array.EnableCopyOnWrite();
+    SliceSequence<int> slice(array, 1, 3);
+    EXPECT_TRUE(array.IsShared());
+    array[1] = 42;
+    EXPECT_FALSE(array.IsShared());
+    EXPECT_EQ(slice.Get(0), 1);
+    EXPECT_EQ(array[1], 42);
+
+    IIterator<int>* it = slice.CreateIterator();
+    int expected = 1;
+    while (it->HasNext())
+    {
+        EXPECT_EQ(it->GetCurrentItem(), expected++);
+        it->Next();
+    }
+    EXPECT_EQ(expected, 4);
+    delete it;
+}
+
+TEST(SequenceTest, ArraySequenceContiguousAccess)
+{
+    // Проверяет: Непрерывный доступ к хранилищу ArraySequence
+    int data[] = {3, 1, 4, 1, 5};
+    ImmutableArraySequence<int> immutableSeq(data, 5);
     
-    EXPECT_EQ(seq.GetLength(), SIZE);
+    EXPECT_EQ(immutableSeq.At(2), 4);
+    EXPECT_EQ(immutableSeq.GetView().GetSize(), 5);
+    EXPECT_EQ(immutableSeq.end() - immutableSeq.begin(), 5);
     
-    // Проверяем что можем получить все элементы
-    for (int i = 0; i < SIZE; i++) {
-        EXPECT_EQ(seq.Get(i), i);
+    MutableArraySequence<int> mutableSeq(data, 5);
+    for (int& value : mutableSeq) 
+    {
+        value *= 2;
     }
+    EXPECT_EQ(mutableSeq.Get(4), 10);
+    mutableSeq.At(0) = 42;
+    EXPECT_EQ(mutableSeq.Data()[0], 42);
     
-    // Проверяем итератор на большом наборе
-    auto iterator = seq.CreateIterator();
-    int count = 0;
-    while (iterator->HasNext()) {
-        iterator->Next();
-        count++;
-    }
-    EXPECT_EQ(count, SIZE);
-    delete iterator;
+    int visited = 0;
+    mutableSeq.ForEachChunk([&visited](const int*, std::int64_t count) 
+    {
+        visited += static_cast<int>(count);
+    });
+    EXPECT_EQ(visited, 5);
+}
+
+TEST(SequenceTest, SizesAreSixtyFourBit)
+{
+    // Проверяет: 64-битные размеры и совместимость с индексами int
+    static_assert(std::is_same<decltype(DynamicArray<int>().GetSize()), std::int64_t>::value, "DynamicArray size must be 64-bit");
+    static_assert(std::is_same<decltype(LinkedList<int>().GetLength()), std::int64_t>::value, "LinkedList length must be 64-bit");
+    static_assert(std::is_same<decltype(MutableArraySequence<int>().GetLength()), std::int64_t>::value, "Sequence length must be 64-bit");
+
+    int data[] = {7, 8, 9};
+    MutableListSequence<int> listSeq(data, 3);
+    const Sequence<int>* seq = &listSeq;
+
+    int intIndex = 1;
+    std::int64_t wideIndex = 2;
+    size_t unsignedIndex = 0;
+    EXPECT_EQ(seq->Get(intIndex), 8);
+    EXPECT_EQ(seq->Get(wideIndex), 9);
+    EXPECT_EQ(seq->Get(unsignedIndex), 7);
+    EXPECT_EQ(seq->GetCount(), 3u);
 }
 
-TEST(SequenceTest, StringSequence) 
+TEST(SequenceTest, StringSequence)
 {
     // Проверяет: Sequence с строковыми типами
     MutableArraySequence<std::string> seq;
@@ -763,6 +1955,190 @@ TEST(SequenceTest, StringSequence)
     EXPECT_EQ(seq.Get(1), "Hello");
 }
 
+TEST(SequenceTest, PersistentSequenceMatchesReference)
+{
+    // Проверяет: Версии персистентной последовательности не меняются после
+    // порождения новых и совпадают с эталонными векторами
+    PersistentSequence<int> current;
+    std::vector<PersistentSequence<int>> versions;
+    std::vector<std::vector<int>> references;
+    std::vector<int> reference;
+    unsigned seed = 11;
+    for (int step = 0; step < 3000; step++)
+    {
+        seed = seed * 1103515245 + 12345;
+        unsigned op = (seed >> 16) % 5;
+        std::int64_t size = static_cast<std::int64_t>(reference.size());
+        std::int64_t index = size > 0 ? static_cast<std::int64_t>(seed >> 8) % size : 0;
+        if (op <= 1 || size == 0)
+        {
+            std::int64_t position = static_cast<std::int64_t>(seed >> 4) % (size + 1);
+            current = current.InsertAt(step, position);
+            reference.insert(reference.begin() + position, step);
+        }
+        else if (op == 2)
+        {
+            current = current.RemoveAt(index);
+            reference.erase(reference.begin() + index);
+        }
+        else if (op == 3)
+        {
+            current = current.Set(index, -step);
+            reference[index] = -step;
+        }
+        else
+        {
+            std::int64_t last = index < 10 ? index : 10;
+            current = current.Concat(current.Slice(0, last));
+            std::vector<int> head(reference.begin(), reference.begin() + last + 1);
+            reference.insert(reference.end(), head.begin(), head.end());
+        }
+        if (step % 300 == 0)
+        {
+            versions.push_back(current);
+            references.push_back(reference);
+        }
+    }
+    for (std::size_t v = 0; v < versions.size(); v++)
+    {
+        ASSERT_EQ(versions[v].GetLength(), static_cast<std::int64_t>(references[v].size()));
+        std::size_t i = 0;
+        IIterator<int>* it = versions[v].CreateIterator();
+        while (it->HasNext())
+        {
+            ASSERT_EQ(it->GetCurrentItem(), references[v][i]);
+            i++;
+            it->Next();
+        }
+        delete it;
+        EXPECT_EQ(i, references[v].size());
+        // Высота AVL-дерева логарифмическая
+        double bound = 1.45 * std::log2(static_cast<double>(references[v].size()) + 2);
+        EXPECT_LE(versions[v].GetHeight(), static_cast<std::int64_t>(bound) + 1);
+    }
+
+    int data[] = {1, 2, 3, 4, 5};
+    PersistentSequence<int> small(data, 5);
+    Sequence<int>* sub = small.GetSubsequence(1, 3);
+    EXPECT_EQ(sub->GetLength(), 3);
+    EXPECT_EQ(sub->GetFirst(), 2);
+    EXPECT_EQ(sub->GetLast(), 4);
+    delete sub;
+    EXPECT_EQ(small.Append(6).GetLast(), 6);
+    EXPECT_EQ(small.Prepend(0).GetFirst(), 0);
+    EXPECT_EQ(small.GetLength(), 5);
+    EXPECT_THROW(small.Get(5), std::out_of_range);
+    EXPECT_THROW(small.Set(-1, 0), std::out_of_range);
+    EXPECT_THROW(PersistentSequence<int>().GetFirst(), std::out_of_range);
+}
+
+TEST(SequenceTest, ChunkedReadMatchesElements)
+{
+    // Проверяет: ForEachChunk и CopyTo выдают те же элементы, что и Get,
+    // для всех видов хранилища; массив отдаётся одним блоком
+    const int COUNT = 1000;
+    std::vector<int> data(COUNT);
+    for (int i = 0; i < COUNT; i++)
+    {
+        data[i] = i * 3;
+    }
+    MutableArraySequence<int> array(data.data(), COUNT);
+    ImmutableArraySequence<int> immutableArray(data.data(), COUNT);
+    Sequence<int>* slice = immutableArray.GetSubsequence(100, 899);
+    MutableListSequence<int> list(data.data(), COUNT);
+    MutableListSequence<int, IndexedSkipList<int>> skipList(data.data(), COUNT);
+    UnrolledListSequence<int> unrolled(data.data(), COUNT);
+    PersistentSequence<int> persistent(data.data(), COUNT);
+    const Sequence<int>* sequences[] = {&array, slice, &list, &skipList, &unrolled, &persistent};
+
+    for (const Sequence<int>* sequence : sequences)
+    {
+        std::vector<int> collected;
+        int chunks = 0;
+        sequence->ForEachChunk([&collected, &chunks](const int* items, std::int64_t count)
+        {
+            collected.insert(collected.end(), items, items + count);
+            chunks++;
+        });
+        ASSERT_EQ(static_cast<std::int64_t>(collected.size()), sequence->GetLength());
+        for (std::int64_t i = 0; i < sequence->GetLength(); i++)
+        {
+            ASSERT_EQ(collected[i], sequence->Get(i));
+        }
+        EXPECT_LE(chunks, 20);
+
+        int copied[50];
+        sequence->CopyTo(copied, 10, 50);
+        for (int i = 0; i < 50; i++)
+        {
+            EXPECT_EQ(copied[i], sequence->Get(10 + i));
+        }
+        EXPECT_THROW(sequence->CopyTo(copied, sequence->GetLength() - 1, 2), std::out_of_range);
+    }
+
+    int arrayChunks = 0;
+    array.ForEachChunk([&arrayChunks, &array](const int* items, std::int64_t count)
+    {
+        EXPECT_EQ(items, array.Data());
+        EXPECT_EQ(count, array.GetLength());
+        arrayChunks++;
+    });
+    EXPECT_EQ(arrayChunks, 1);
+
+    MutableListSequence<int> empty;
+    int emptyChunks = 0;
+    empty.ForEachChunk([&emptyChunks](const int*, std::int64_t) { emptyChunks++; });
+    EXPECT_EQ(emptyChunks, 0);
+    delete slice;
+}
+
+TEST(SequenceTest, PipelineFusesStages)
+{
+    // Проверяет: Ленивый конвейер даёт тот же результат, что и поэтапная обработка,
+    // и Take прекращает обход источника
+    const int COUNT = 100000;
+    std::vector<int> data(COUNT);
+    for (int i = 0; i < COUNT; i++)
+    {
+        data[i] = i;
+    }
+    MutableArraySequence<int> array(data.data(), COUNT);
+    MutableListSequence<int> list(data.data(), COUNT);
+
+    long long expected = 0;
+    for (int value : data)
+    {
+        if (value % 3 == 0) expected += static_cast<long long>(value) * 2;
+    }
+    for (const Sequence<int>* source : {static_cast<const Sequence<int>*>(&array), static_cast<const Sequence<int>*>(&list)})
+    {
+        long long sum = From(source)
+            .Where([](int value) { return value % 3 == 0; })
+            .Map([](int value) { return static_cast<long long>(value) * 2; })
+            .Reduce(0LL, [](long long total, long long value) { return total + value; });
+        EXPECT_EQ(sum, expected);
+
+        int inspected = 0;
+        MutableArraySequence<int> firstFive = From(source)
+            .Where([&inspected](int value) { inspected++; return value % 2 == 1; })
+            .Take(5)
+            .ToArraySequence();
+        ASSERT_EQ(firstFive.GetLength(), 5);
+        EXPECT_EQ(firstFive.Get(0), 1);
+        EXPECT_EQ(firstFive.Get(4), 9);
+        EXPECT_LE(inspected, 512);
+    }
+
+    MutableArraySequence<double> halves = From(array).Skip(COUNT - 3).Map([](int value) { return value / 2.0; }).ToArraySequence();
+    ASSERT_EQ(halves.GetLength(), 3);
+    EXPECT_DOUBLE_EQ(halves.GetFirst(), (COUNT - 3) / 2.0);
+    EXPECT_EQ(From(array).Take(0).Count(), 0);
+    EXPECT_EQ(From(list).Where([](int value) { return value < 10; }).Count(), 10);
+    EXPECT_TRUE(From(list).Any([](int value) { return value == 42; }));
+    EXPECT_FALSE(From(array).Take(10).Any([](int value) { return value == 42; }));
+    EXPECT_THROW(From(array).Take(-1), std::invalid_argument);
+}
+
 // 4. Тесты BinaryTree
 
 TEST(BinaryTreeTest, EmptyTreeOperations) 
@@ -1046,6 +2422,297 @@ TEST(BinaryTreeTest, TreeBalanceEmpty)
     EXPECT_TRUE(tree.isEmpty());
 }
 
+// Проверяет AVL-условие и хранимые высоты; возвращает высоту поддерева
+static int CheckAvlNode(Node<int>* node)
+{
+    if (node == nullptr) return 0;
+    int left = CheckAvlNode(node->left);
+    int right = CheckAvlNode(node->right);
+    EXPECT_LE(left - right, 1);
+    EXPECT_LE(right - left, 1);
+    int height = (left > right ? left : right) + 1;
+    EXPECT_EQ(node->height, height);
+    return height;
+}
+
+TEST(BinaryTreeTest, SelfBalancingOnSortedKeys) 
+{
+    // Проверяет: В режиме самобалансировки упорядоченные вставки и удаления
+    // сохраняют высоту O(log n); обычное дерево остаётся несбалансированным
+    const int COUNT = 20000;
+    BinaryTree<int> plain;
+    BinaryTree<int> balanced;
+    balanced.enableSelfBalancing();
+    EXPECT_TRUE(balanced.isSelfBalancing());
+    for (int i = 0; i < 200; i++) 
+    {
+        plain.insert(i);
+    }
+    EXPECT_EQ(plain.getHeight(), 200);
+    for (int i = 0; i < COUNT; i++) 
+    {
+        balanced.insert(i);
+        balanced.insert(i);
+    }
+    // Для AVL-дерева h < 1.45 * log2(n + 2)
+    EXPECT_LE(balanced.getHeight(), 1.45 * std::log2(COUNT + 2.0));
+    CheckAvlNode(balanced.getRoot());
+
+    for (int i = 0; i < COUNT; i += 3) 
+    {
+        balanced.remove(i);
+    }
+    for (int i = COUNT - 1; i > COUNT / 2; i -= 2) 
+    {
+        balanced.remove(i);
+    }
+    CheckAvlNode(balanced.getRoot());
+    int previous = -1;
+    int count = 0;
+    balanced.traverseInOrder([&previous, &count](int value) 
+    {
+        EXPECT_LT(previous, value);
+        previous = value;
+        count++;
+    });
+    for (int i = 0; i < COUNT; i++) 
+    {
+        bool removed = i % 3 == 0 || (i > COUNT / 2 && (COUNT - 1 - i) % 2 == 0);
+        ASSERT_EQ(balanced.contains(i), !removed);
+    }
+
+    BinaryTree<int> copy(balanced);
+    EXPECT_TRUE(copy.isSelfBalancing());
+    EXPECT_EQ(copy.getHeight(), balanced.getHeight());
+
+    // Включение на непустом дереве перестраивает его
+    plain.enableSelfBalancing();
+    CheckAvlNode(plain.getRoot());
+    EXPECT_LE(plain.getHeight(), 8);
+}
+
+TEST(BinaryTreeTest, DegenerateTreeOperations) 
+{
+    // Проверяет: Обходы, копирование, удаление и очистка работают на
+    // вырожденном дереве-цепочке без рекурсии
+    const int COUNT = 5000;
+    BinaryTree<int> tree;
+    for (int i = 0; i < COUNT; i++) 
+    {
+        tree.insert(i);
+    }
+    EXPECT_EQ(tree.getHeight(), COUNT);
+
+    long long preSum = 0;
+    int expected = 0;
+    tree.traversePreOrder([&preSum, &expected](int value) 
+    {
+        EXPECT_EQ(value, expected++);
+        preSum += value;
+    });
+    expected = 0;
+    tree.traverseInOrder([&expected](int value) 
+    {
+        EXPECT_EQ(value, expected++);
+    });
+    expected = COUNT - 1;
+    tree.traversePostOrder([&expected](int value) 
+    {
+        EXPECT_EQ(value, expected--);
+    });
+    EXPECT_EQ(preSum, static_cast<long long>(COUNT) * (COUNT - 1) / 2);
+
+    BinaryTree<int> copy(tree);
+    EXPECT_EQ(copy.getHeight(), COUNT);
+    EXPECT_TRUE(copy.contains(COUNT - 1));
+    EXPECT_EQ(copy.serialize().GetSize(), tree.serialize().GetSize());
+
+    for (int i = 0; i < COUNT; i += 2) 
+    {
+        copy.remove(i);
+    }
+    EXPECT_EQ(copy.getHeight(), COUNT / 2);
+    EXPECT_FALSE(copy.contains(0));
+    EXPECT_TRUE(copy.contains(1));
+
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+    copy.clear();
+    EXPECT_TRUE(copy.isEmpty());
+}
+
+TEST(BinaryTreeTest, RemoveNodeWithTwoChildrenRelinksSuccessor) 
+{
+    // Проверяет: При удалении узла с двумя потомками его место занимает
+    // преемник, а указатели на остальные узлы остаются действительными
+    BinaryTree<int> tree;
+    for (int value : {50, 30, 70, 60, 80, 65, 20}) 
+    {
+        tree.insert(value);
+    }
+    Node<int>* successor = tree.findNode(60);
+    Node<int>* other = tree.findNode(65);
+    tree.remove(50);
+    EXPECT_EQ(tree.getRoot(), successor);
+    EXPECT_EQ(tree.getRoot()->data, 60);
+    EXPECT_EQ(tree.findNode(65), other);
+    EXPECT_EQ(tree.getRoot()->right->left, other);
+    std::vector<int> values;
+    tree.traverseInOrder([&values](int value) 
+    {
+        values.push_back(value);
+    });
+    EXPECT_EQ(values, std::vector<int>({20, 30, 60, 65, 70, 80}));
+}
+
+// Замер: 10 млн упорядоченных ключей в самобалансирующемся дереве и
+// 50 тыс. в вырожденном; обход, копирование и очистка не переполняют стек.
+// Запуск: --gtest_also_run_disabled_tests --gtest_filter=*SortedKeysStress*
+TEST(BinaryTreeTest, DISABLED_SortedKeysStress) 
+{
+    auto measure = [](const char* label, std::function<void()> action) 
+    {
+        auto start = std::chrono::steady_clock::now();
+        action();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << label << ": " << elapsed.count() << " мс" << std::endl;
+    };
+
+    const int BALANCED_COUNT = 10000000;
+    BinaryTree<int> balanced;
+    balanced.enableSelfBalancing();
+    measure("вставка 10 млн", [&balanced]() 
+    {
+        for (int i = 0; i < BALANCED_COUNT; i++) 
+        {
+            balanced.insert(i);
+        }
+    });
+    long long sum = 0;
+    measure("обход", [&balanced, &sum]() 
+    {
+        balanced.traverseInOrder([&sum](int value) { sum += value; });
+    });
+    EXPECT_EQ(sum, static_cast<long long>(BALANCED_COUNT) * (BALANCED_COUNT - 1) / 2);
+    measure("копирование", [&balanced]() 
+    {
+        BinaryTree<int> copy(balanced);
+        EXPECT_EQ(copy.getHeight(), balanced.getHeight());
+    });
+    measure("очистка", [&balanced]() { balanced.clear(); });
+
+    const int DEGENERATE_COUNT = 50000;
+    BinaryTree<int> chain;
+    measure("вставка 50 тыс. в цепочку", [&chain]() 
+    {
+        for (int i = 0; i < DEGENERATE_COUNT; i++) 
+        {
+            chain.insert(i);
+        }
+    });
+    EXPECT_EQ(chain.getHeight(), DEGENERATE_COUNT);
+    int visited = 0;
+    chain.traversePostOrder([&visited](int) { visited++; });
+    EXPECT_EQ(visited, DEGENERATE_COUNT);
+    BinaryTree<int> chainCopy(chain);
+    EXPECT_EQ(chainCopy.getHeight(), DEGENERATE_COUNT);
+    chainCopy.clear();
+    chain.clear();
+}
+
+// Проверяет хранимые размеры поддеревьев; возвращает размер
+static std::int64_t CheckSubtreeSizes(Node<int>* node)
+{
+    if (node == nullptr) return 0;
+    std::int64_t size = CheckSubtreeSizes(node->left) + CheckSubtreeSizes(node->right) + 1;
+    EXPECT_EQ(node->size, size);
+    return size;
+}
+
+TEST(BinaryTreeTest, OrderStatisticsMatchReference) 
+{
+    // Проверяет: size, select и rank совпадают с упорядоченным эталоном
+    // после случайных вставок и удалений в обоих режимах дерева
+    for (bool selfBalancing : {false, true}) 
+    {
+        BinaryTree<int> tree;
+        if (selfBalancing) tree.enableSelfBalancing();
+        std::set<int> reference;
+        unsigned seed = 21;
+        for (int step = 0; step < 6000; step++) 
+        {
+            seed = seed * 1103515245 + 12345;
+            int value = static_cast<int>((seed >> 16) % 2000);
+            if (step % 3 == 2) 
+            {
+                tree.remove(value);
+                reference.erase(value);
+            } 
+            else 
+            {
+                tree.insert(value);
+                reference.insert(value);
+            }
+        }
+        ASSERT_EQ(tree.size(), static_cast<std::int64_t>(reference.size()));
+        CheckSubtreeSizes(tree.getRoot());
+        std::int64_t index = 0;
+        for (int value : reference) 
+        {
+            ASSERT_EQ(tree.select(index), value);
+            ASSERT_EQ(tree.rank(value), index);
+            index++;
+        }
+        EXPECT_EQ(tree.rank(-1), 0);
+        EXPECT_EQ(tree.rank(5000), tree.size());
+        EXPECT_THROW(tree.select(tree.size()), std::out_of_range);
+        EXPECT_THROW(tree.select(-1), std::out_of_range);
+
+        BinaryTree<int> copy(tree);
+        EXPECT_EQ(copy.size(), tree.size());
+        tree.balance();
+        CheckSubtreeSizes(tree.getRoot());
+        tree.clear();
+        EXPECT_EQ(tree.size(), 0);
+    }
+}
+
+TEST(BinaryTreeTest, SortedSequenceIndexesFromTree) 
+{
+    // Проверяет: SortedSequence отдаёт элементы по индексу и позицию
+    // элемента прямо из дерева, в том числе сразу после изменений
+    SortedSequence<int> sequence;
+    for (int value : {50, 10, 40, 20, 30, 10}) 
+    {
+        sequence.Add(value);
+    }
+    EXPECT_EQ(sequence.GetLength(), 5);
+    EXPECT_EQ(sequence.GetFirst(), 10);
+    EXPECT_EQ(sequence.GetLast(), 50);
+    EXPECT_EQ(sequence.Get(2), 30);
+    EXPECT_EQ(sequence.IndexOf(40), 3);
+    EXPECT_EQ(sequence.IndexOf(35), -1);
+
+    sequence.Remove(20);
+    EXPECT_EQ(sequence.Get(1), 30);
+    EXPECT_EQ(sequence.IndexOf(50), 3);
+    sequence.Add(5);
+    EXPECT_EQ(sequence.Get(0), 5);
+    EXPECT_EQ(sequence.IndexOf(50), 4);
+
+    Sequence<int>* sub = sequence.GetSubsequence(1, 3);
+    ASSERT_EQ(sub->GetLength(), 3);
+    EXPECT_EQ(sub->Get(0), 10);
+    EXPECT_EQ(sub->Get(2), 40);
+    delete sub;
+    EXPECT_THROW(sequence.GetSubsequence(2, 5), std::out_of_range);
+    EXPECT_THROW(sequence.Get(5), std::out_of_range);
+
+    sequence.Clear();
+    EXPECT_EQ(sequence.GetLength(), 0);
+    EXPECT_THROW(sequence.GetFirst(), std::out_of_range);
+}
+
 TEST(BinaryTreeTest, TreeCopyConstructor) 
 {
     // Проверяет: Конструктор копирования для дерева
@@ -1404,41 +3071,237 @@ TEST(BinaryTreeTest, StringBinaryTreeOperations)
     EXPECT_FALSE(uppercaseTree.contains("apple")); // В нижнем регистре
 }
 
-// 5. Тесты Dictionary с простыми типами
+// 5. Тесты Dictionary с простыми типами
+
+TEST(DictionaryTest, EmptyDictionaryOperations) 
+{
+    // Проверяет: Операции с пустым словарем
+    Dictionary<int, std::string> dict;
+    EXPECT_TRUE(dict.IsEmpty());
+    EXPECT_EQ(dict.GetCount(), 0);
+    EXPECT_FALSE(dict.ContainsKey(1));
+    EXPECT_THROW(dict.Get(1), std::runtime_error);
+}
+
+TEST(DictionaryTest, BasicAddAndGet) 
+{
+    // Проверяет: Базовое добавление и получение элементов
+    Dictionary<int, std::string> dict;
+    dict.Add(1, "one");
+    dict.Add(2, "two");
+    
+    EXPECT_EQ(dict.GetCount(), 2);
+    EXPECT_TRUE(dict.ContainsKey(1));
+    EXPECT_TRUE(dict.ContainsKey(2));
+    EXPECT_EQ(dict.Get(1), "one");
+    EXPECT_EQ(dict.Get(2), "two");
+}
+
+TEST(DictionaryTest, AddDuplicateKey) 
+{
+    // Проверяет: Добавление дублирующегося ключа
+    Dictionary<int, std::string> dict;
+    dict.Add(1, "old");
+    dict.Add(1, "new");
+    
+    EXPECT_EQ(dict.GetCount(), 1);
+    EXPECT_EQ(dict.Get(1), "new");
+}
+
+TEST(DictionaryTest, UpsertInPlace) 
+{
+    // Проверяет: FindOrInsert, AddOrUpdate, Increment и Find меняют и
+    // читают значения на месте
+    Dictionary<SmallString, int> dict;
+    dict.FindOrInsert("a") = 5;
+    dict.FindOrInsert("a") += 2;
+    EXPECT_EQ(dict.Get("a"), 7);
+    EXPECT_EQ(dict.FindOrInsert("b"), 0);
+    EXPECT_EQ(dict.GetCount(), 2);
+
+    dict.AddOrUpdate("c", 3, [](int current, int value) { return current * value; });
+    dict.AddOrUpdate("c", 4, [](int current, int value) { return current * value; });
+    EXPECT_EQ(dict.Get("c"), 12);
+
+    dict.Increment("d", 1);
+    dict.Increment("d", 1);
+    dict.Increment("a", -7);
+    EXPECT_EQ(dict.Get("d"), 2);
+    EXPECT_EQ(dict.Get("a"), 0);
+
+    ASSERT_NE(dict.Find("c"), nullptr);
+    EXPECT_EQ(*dict.Find("c"), 12);
+    EXPECT_EQ(dict.Find("z"), nullptr);
+    EXPECT_EQ(dict.GetCount(), 4);
+
+    dict.Add("d", 10);
+    EXPECT_EQ(dict.Get("d"), 10);
+    EXPECT_EQ(dict.GetCount(), 4);
+}
+
+// Ключ, считающий сравнения
+struct CountedKey 
+{
+    int value;
+    static long long comparisons;
+
+    CountedKey(int value = 0) : value(value) {}
+
+    bool operator<(const CountedKey& other) const 
+    {
+        comparisons++;
+        return value < other.value;
+    }
+
+    bool operator==(const CountedKey& other) const 
+    {
+        comparisons++;
+        return value == other.value;
+    }
+};
+
+long long CountedKey::comparisons = 0;
+
+TEST(DictionaryTest, IncrementDescendsOnce) 
+{
+    // Проверяет: Increment проходит дерево один раз — не больше двух
+    // сравнений ключей на уровень AVL-дерева (высота 1000 ключей не выше 14)
+    const int KEYS = 1000;
+    const int ROUNDS = 20;
+    Dictionary<CountedKey, int> dict;
+    for (int key = 0; key < KEYS; key++) 
+    {
+        dict.Add(key, 0);
+    }
+
+    CountedKey::comparisons = 0;
+    for (int round = 0; round < ROUNDS; round++) 
+    {
+        for (int key = 0; key < KEYS; key++) 
+        {
+            dict.Increment(key, 1);
+        }
+    }
+    EXPECT_LE(CountedKey::comparisons, static_cast<long long>(KEYS) * ROUNDS * 2 * 14);
+
+    // Прежний способ: ContainsKey, Get, Remove и Add — четыре спуска
+    CountedKey::comparisons = 0;
+    for (int key = 0; key < KEYS; key++) 
+    {
+        if (dict.ContainsKey(key)) 
+        {
+            int current = dict.Get(key);
+            dict.Remove(key);
+            dict.Add(key, current + 1);
+        }
+    }
+    long long oldComparisons = CountedKey::comparisons;
+    CountedKey::comparisons = 0;
+    for (int key = 0; key < KEYS; key++) 
+    {
+        dict.Increment(key, 1);
+    }
+    EXPECT_LT(CountedKey::comparisons * 2, oldComparisons);
+
+    for (int key = 0; key < KEYS; key++) 
+    {
+        ASSERT_EQ(dict.Get(key), ROUNDS + 2);
+    }
+}
+
+// Ключ и значение, считающие созданные копии
+struct TrackedKey 
+{
+    int value;
+    static int copies;
+
+    TrackedKey(int value = 0) : value(value) {}
+    TrackedKey(const TrackedKey& other) : value(other.value) 
+    {
+        copies++;
+    }
+    TrackedKey& operator=(const TrackedKey& other) 
+    {
+        value = other.value;
+        copies++;
+        return *this;
+    }
+    bool operator<(const TrackedKey& other) const 
+    {
+        return value < other.value;
+    }
+    bool operator==(const TrackedKey& other) const 
+    {
+        return value == other.value;
+    }
+};
+
+int TrackedKey::copies = 0;
 
-TEST(DictionaryTest, EmptyDictionaryOperations) 
+struct TrackedValue 
 {
-    // Проверяет: Операции с пустым словарем
-    Dictionary<int, std::string> dict;
-    EXPECT_TRUE(dict.IsEmpty());
-    EXPECT_EQ(dict.GetCount(), 0);
-    EXPECT_FALSE(dict.ContainsKey(1));
-    EXPECT_THROW(dict.Get(1), std::runtime_error);
-}
+    int value;
+    static int constructions;
 
-TEST(DictionaryTest, BasicAddAndGet) 
-{
-    // Проверяет: Базовое добавление и получение элементов
-    Dictionary<int, std::string> dict;
-    dict.Add(1, "one");
-    dict.Add(2, "two");
-    
-    EXPECT_EQ(dict.GetCount(), 2);
-    EXPECT_TRUE(dict.ContainsKey(1));
-    EXPECT_TRUE(dict.ContainsKey(2));
-    EXPECT_EQ(dict.Get(1), "one");
-    EXPECT_EQ(dict.Get(2), "two");
-}
+    TrackedValue() : value(0) 
+    {
+        constructions++;
+    }
+    TrackedValue(int value) : value(value) 
+    {
+        constructions++;
+    }
+    TrackedValue(const TrackedValue& other) : value(other.value) 
+    {
+        constructions++;
+    }
+    TrackedValue& operator=(const TrackedValue& other) = default;
+};
 
-TEST(DictionaryTest, AddDuplicateKey) 
+int TrackedValue::constructions = 0;
+
+TEST(DictionaryTest, LookupWithoutProbePairs) 
 {
-    // Проверяет: Добавление дублирующегося ключа
-    Dictionary<int, std::string> dict;
-    dict.Add(1, "old");
-    dict.Add(1, "new");
-    
-    EXPECT_EQ(dict.GetCount(), 1);
-    EXPECT_EQ(dict.Get(1), "new");
+    // Проверяет: ContainsKey, Find и Remove не копируют ключ и не создают
+    // значений; строковые словари ищут по ArrayView<char>
+    Dictionary<TrackedKey, TrackedValue> dict;
+    for (int i = 0; i < 100; i++) 
+    {
+        dict.Add(TrackedKey(i), TrackedValue(i * 10));
+    }
+    TrackedKey key(42);
+    TrackedKey missing(1000);
+    TrackedKey::copies = 0;
+    TrackedValue::constructions = 0;
+    EXPECT_TRUE(dict.ContainsKey(key));
+    EXPECT_FALSE(dict.ContainsKey(missing));
+    ASSERT_NE(dict.Find(key), nullptr);
+    EXPECT_EQ(dict.Find(key)->value, 420);
+    dict.Remove(key);
+    dict.Remove(missing);
+    EXPECT_EQ(TrackedKey::copies, 0);
+    EXPECT_EQ(TrackedValue::constructions, 0);
+    EXPECT_FALSE(dict.ContainsKey(key));
+    EXPECT_EQ(dict.GetCount(), 99);
+
+    Dictionary<SmallString, int> words;
+    words.Add("alpha", 1);
+    words.Add("a-much-longer-key-kept-on-the-heap", 2);
+    const char* text = "xx alpha a-much-longer-key-kept-on-the-heap";
+    EXPECT_TRUE(words.ContainsKey(ArrayView<char>(text + 3, 5)));
+    EXPECT_FALSE(words.ContainsKey(ArrayView<char>(text + 3, 4)));
+    EXPECT_EQ(words.Get(ArrayView<char>(text + 9, 34)), 2);
+    ASSERT_NE(words.Find(ArrayView<char>(text + 3, 5)), nullptr);
+    EXPECT_EQ(*words.Find(ArrayView<char>(text + 3, 5)), 1);
+    EXPECT_THROW(words.Get(ArrayView<char>(text, 2)), std::runtime_error);
+    words.Remove(ArrayView<char>(text + 3, 5));
+    EXPECT_FALSE(words.ContainsKey("alpha"));
+    EXPECT_EQ(words.GetCount(), 1);
+
+    Dictionary<DynamicArray<char>, int> arrays;
+    arrays.Add(StringToDynamicArray("key"), 7);
+    EXPECT_EQ(arrays.Get(ArrayView<char>("key", 3)), 7);
+    EXPECT_TRUE(arrays.ContainsKey(StringToDynamicArray("key")));
 }
 
 TEST(DictionaryTest, RemoveOperations) 
@@ -1732,6 +3595,28 @@ TEST(HistogramTest, HistogramMapReduce)
 }
 
 
+TEST(HistogramTest, ListAndArraySequencesGiveSameCounts) 
+{
+    // Проверяет: Одинаковый результат для массива и списка
+    double testData[] = {0.5, 1.5, 1.7, 2.5, 3.5, 3.9, 3.2};
+    MutableArraySequence<double> arraySequence(testData, 7);
+    MutableListSequence<double> listSequence(testData, 7);
+    
+    Histogram<double> fromArray;
+    fromArray.CreateUniformRanges(0.0, 4.0, 4);
+    fromArray.BuildHistogram(&arraySequence);
+    
+    Histogram<double> fromList;
+    fromList.CreateUniformRanges(0.0, 4.0, 4);
+    fromList.BuildHistogram(&listSequence);
+    
+    EXPECT_EQ(fromArray.GetTotalCount(), 7);
+    EXPECT_EQ(fromList.GetTotalCount(), 7);
+    EXPECT_TRUE(StringsEqual(fromArray.GetMostFrequentRange(), fromList.GetMostFrequentRange()));
+    EXPECT_EQ(fromArray.GetCounts().Get(fromArray.FindRange(3.5)), 3);
+    EXPECT_EQ(fromList.GetCounts().Get(fromList.FindRange(1.5)), 2);
+}
+
 TEST(HistogramTest, ClearHistogram) 
 {
     // Проверяет: Очистку гистограммы
@@ -1940,6 +3825,26 @@ TEST(MostFrequentSubstringsTest, RepeatedPatternString)
     delete sequence;
 }
 
+TEST(MostFrequentSubstringsTest, LongSubstringsCountedInPlace) 
+{
+    // Проверяет: Длинные подстроки ищутся по диапазону текста,
+    // ключ строится только для новой подстроки
+    std::string testStr(64, 'a');
+    testStr += 'b';
+    MutableArraySequence<char> sequence(testStr.data(), static_cast<std::int64_t>(testStr.size()));
+    
+    MostFrequentSubstrings finder;
+    finder.FindMostFrequent(&sequence, 20, 20);
+    EXPECT_EQ(finder.GetTotalCount(), 46);
+    EXPECT_EQ(finder.GetUniqueCount(), 2);
+    
+    auto topResults = finder.GetTopFrequent(1);
+    ASSERT_EQ(topResults->GetLength(), 1);
+    EXPECT_EQ(topResults->Get(0).count, 45);
+    EXPECT_EQ(topResults->Get(0).substring, SmallString(std::string(20, 'a').c_str()));
+    delete topResults;
+}
+
 TEST(MostFrequentSubstringsTest, ComplexStringAnalysis) 
 {
     // Проверяет: Анализ сложной строки для поиска подстрок
@@ -2150,7 +4055,718 @@ TEST(IntegrationTest, CompleteWorkflow)
     }
 }
 
-int main(int argc, char **argv) 
+// 10. Тесты источников памяти
+
+namespace
+{
+    // Передаёт запросы глобальному new/delete и считает их
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        int allocations = 0;
+        int deallocations = 0;
+        std::int64_t bytesInUse = 0;
+        std::int64_t largestAllocation = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            allocations++;
+            bytesInUse += static_cast<std::int64_t>(bytes);
+            largestAllocation = std::max(largestAllocation, static_cast<std::int64_t>(bytes));
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+        {
+            deallocations++;
+            bytesInUse -= static_cast<std::int64_t>(bytes);
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+TEST(MemoryResourceTest, ContainersAllocateFromResource)
+{
+    // Проверяет: Массив, список и дерево берут память из переданного источника
+    CountingResource resource;
+    {
+        DynamicArray<int> arr(0, &resource);
+        for (int i = 0; i < 100; i++)
+        {
+            arr.PushBack(i);
+        }
+        LinkedList<int> list(&resource);
+        list.Append(1);
+        list.Prepend(0);
+        BinaryTree<int> tree(&resource);
+        tree.insert(5);
+        tree.insert(3);
+        tree.remove(5);
+        Dictionary<int, int> dict(&resource);
+        dict.Add(1, 10);
+
+        EXPECT_EQ(arr.GetResource(), &resource);
+        EXPECT_GT(resource.allocations, 0);
+        EXPECT_GT(resource.bytesInUse, 0);
+
+        // Копии, как и в std::pmr, используют источник по умолчанию
+        DynamicArray<int> copy = arr;
+        EXPECT_EQ(copy.GetResource(), std::pmr::get_default_resource());
+        EXPECT_EQ(copy.Get(99), 99);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+    EXPECT_EQ(resource.bytesInUse, 0);
+}
+
+TEST(MemoryResourceTest, MoveBetweenResourcesKeepsOwnResource)
+{
+    // Проверяет: Перемещение между разными источниками не смешивает их память
+    CountingResource first;
+    CountingResource second;
+    {
+        DynamicArray<std::string> source(0, &first);
+        source.PushBack("alpha");
+        source.PushBack("beta");
+        DynamicArray<std::string> target(0, &second);
+        target = std::move(source);
+        EXPECT_EQ(target.GetResource(), &second);
+        EXPECT_EQ(target.GetSize(), 2);
+        EXPECT_EQ(target[1], "beta");
+
+        LinkedList<int> listSource(&first);
+        listSource.Append(7);
+        LinkedList<int> listTarget(&second);
+        listTarget = std::move(listSource);
+        EXPECT_EQ(listTarget.GetFirst(), 7);
+        EXPECT_EQ(listTarget.GetResource(), &second);
+    }
+    EXPECT_EQ(first.bytesInUse, 0);
+    EXPECT_EQ(second.bytesInUse, 0);
+}
+
+TEST(MemoryResourceTest, AnalysisRunOnArena)
+{
+    // Проверяет: Поиск подстрок и гистограмма работают поверх арены
+    CountingResource upstream;
+    {
+        std::pmr::monotonic_buffer_resource arena(&upstream);
+        const char* text = "abcabcabc";
+        MutableListSequence<char> sequence(text, 9);
+
+        MostFrequentSubstrings finder(&arena);
+        finder.FindMostFrequent(&sequence, 2, 3);
+        EXPECT_EQ(finder.GetTotalCount(), 15);
+        EXPECT_GT(upstream.allocations, 0);
+
+        Histogram<int> histogram(&arena);
+        histogram.CreateUniformRanges(0, 10, 2);
+        int values[] = {1, 2, 7};
+        MutableArraySequence<int> data(values, 3);
+        histogram.BuildHistogram(&data);
+        EXPECT_EQ(histogram.GetTotalCount(), 3);
+    }
+    EXPECT_EQ(upstream.bytesInUse, 0);
+}
+
+TEST(MemoryResourceTest, NodePoolReusesBlocks)
+{
+    // Проверяет: Пул переиспользует освобождённые блоки и освобождает плиты разом
+    CountingResource upstream;
+    {
+        NodePool pool(&upstream);
+        void* first = pool.allocate(24, alignof(void*));
+        void* second = pool.allocate(24, alignof(void*));
+        EXPECT_NE(first, second);
+        EXPECT_EQ(pool.GetBlocksInUse(), 2);
+        EXPECT_EQ(pool.GetSlabCount(), 1);
+
+        pool.deallocate(first, 24, alignof(void*));
+        void* reused = pool.allocate(20, alignof(void*));
+        EXPECT_EQ(reused, first);
+
+        DynamicArray<void*> blocks;
+        for (int i = 0; i < 10000; i++)
+        {
+            blocks.PushBack(pool.allocate(48, alignof(void*)));
+        }
+        EXPECT_NE(blocks[0], nullptr);
+        EXPECT_NE(blocks[0], blocks[1]);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(blocks[9999]) % alignof(void*), 0u);
+        EXPECT_GT(pool.GetSlabCount(), 1);
+        int slabAllocations = upstream.allocations;
+
+        pool.Release();
+        EXPECT_EQ(pool.GetSlabCount(), 0);
+        EXPECT_EQ(pool.GetBlocksInUse(), 0);
+        EXPECT_EQ(upstream.deallocations, slabAllocations);
+        EXPECT_EQ(upstream.bytesInUse, 0);
+
+        // Крупные запросы уходят к вышестоящему источнику
+        void* large = pool.allocate(1024, alignof(void*));
+        EXPECT_EQ(pool.GetSlabCount(), 0);
+        pool.deallocate(large, 1024, alignof(void*));
+    }
+    EXPECT_EQ(upstream.bytesInUse, 0);
+}
+
+TEST(MemoryResourceTest, PooledContainersReleaseNodesInBulk)
+{
+    // Проверяет: Деревья, списки и словари на пуле очищаются одним шагом
+    CountingResource upstream;
+    {
+        BinaryTree<int> tree(&upstream);
+        tree.enableNodePool();
+        EXPECT_TRUE(tree.hasNodePool());
+        for (int i = 0; i < 1000; i++)
+        {
+            tree.insert((i * 7919) % 1000);
+        }
+        int allocationsBeforeClear = upstream.allocations;
+        EXPECT_LT(allocationsBeforeClear, 20);
+        tree.clear();
+        EXPECT_TRUE(tree.isEmpty());
+        EXPECT_EQ(upstream.bytesInUse, 0);
+        tree.insert(1);
+        EXPECT_TRUE(tree.contains(1));
+        BinaryTree<int> filled;
+        filled.insert(1);
+        EXPECT_THROW(filled.enableNodePool(), std::logic_error);
+
+        LinkedList<std::string> list(&upstream);
+        list.EnableNodePool();
+        for (int i = 0; i < 100; i++)
+        {
+            list.Append(std::string(40, 'a' + i % 26));
+        }
+        LinkedList<std::string> moved(std::move(list));
+        EXPECT_EQ(moved.GetLength(), 100);
+        EXPECT_TRUE(moved.HasNodePool());
+        list.Append("after move");
+        EXPECT_EQ(list.GetFirst(), "after move");
+
+        Dictionary<int, int> dict(&upstream);
+        dict.EnableNodePool();
+        const int COUNT = 200000;
+        for (int i = 0; i < COUNT; i++)
+        {
+            dict.Add((i * 7919) % COUNT, i);
+        }
+        for (int i = 0; i < COUNT; i += 2)
+        {
+            dict.Remove(i);
+        }
+        EXPECT_EQ(dict.GetCount(), COUNT / 2);
+        dict.Clear();
+        EXPECT_TRUE(dict.IsEmpty());
+    }
+    EXPECT_EQ(upstream.bytesInUse, 0);
+}
+
+namespace
+{
+    struct LargeNodeValue
+    {
+        int key;
+        char payload[300];
+
+        LargeNodeValue(int key = 0) : key(key)
+        {
+            payload[0] = static_cast<char>(key);
+        }
+        bool operator<(const LargeNodeValue& other) const
+        {
+            return key < other.key;
+        }
+        bool operator==(const LargeNodeValue& other) const
+        {
+            return key == other.key;
+        }
+    };
+
+    struct alignas(128) OverAlignedValue
+    {
+        int key;
+
+        OverAlignedValue(int key = 0) : key(key) {}
+        bool operator<(const OverAlignedValue& other) const
+        {
+            return key < other.key;
+        }
+        bool operator==(const OverAlignedValue& other) const
+        {
+            return key == other.key;
+        }
+    };
+}
+
+TEST(MemoryResourceTest, PooledContainersReleaseLargeNodes)
+{
+    // Проверяет: Узлы крупнее блока пула и сверхвыровненные узлы
+    // возвращаются вышестоящему источнику при массовой очистке
+    CountingResource upstream;
+    {
+        LinkedList<LargeNodeValue> list(&upstream);
+        list.EnableNodePool();
+        for (int i = 0; i < 50; i++)
+        {
+            list.Append(LargeNodeValue(i));
+        }
+        EXPECT_EQ(list.Get(49).key, 49);
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+    EXPECT_EQ(upstream.bytesInUse, 0);
+    {
+
+        BinaryTree<LargeNodeValue> tree(&upstream);
+        tree.enableNodePool();
+        for (int i = 0; i < 50; i++)
+        {
+            tree.insert(LargeNodeValue((i * 7) % 50));
+        }
+        tree.remove(LargeNodeValue(3));
+        EXPECT_FALSE(tree.contains(LargeNodeValue(3)));
+        tree.clear();
+        EXPECT_EQ(upstream.allocations, upstream.deallocations);
+        EXPECT_EQ(upstream.bytesInUse, 0);
+
+        BinaryTree<OverAlignedValue> aligned(&upstream);
+        aligned.enableNodePool();
+        for (int i = 0; i < 20; i++)
+        {
+            aligned.insert(OverAlignedValue(i));
+        }
+        EXPECT_TRUE(aligned.contains(OverAlignedValue(7)));
+        // Без очистки: пул освобождается в деструкторе дерева
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+    EXPECT_EQ(upstream.bytesInUse, 0);
+
+    NodePool pool(&upstream);
+    void* first = pool.allocate(1024, alignof(void*));
+    void* second = pool.allocate(64, 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 256, 0u);
+    EXPECT_EQ(pool.GetLargeBlockCount(), 2);
+    pool.deallocate(first, 1024, alignof(void*));
+    EXPECT_EQ(pool.GetLargeBlockCount(), 1);
+    pool.Release();
+    EXPECT_EQ(pool.GetLargeBlockCount(), 0);
+    EXPECT_EQ(upstream.bytesInUse, 0);
+}
+
+TEST(MemoryResourceTest, PersistentVersionsShareNodes)
+{
+    // Проверяет: Новая версия выделяет узлы только на пути от корня,
+    // а освобождение версии не затрагивает разделённые узлы
+    CountingResource resource;
+    {
+        const int COUNT = 100000;
+        std::vector<int> data(COUNT);
+        for (int i = 0; i < COUNT; i++)
+        {
+            data[i] = i;
+        }
+        PersistentSequence<int> base(data.data(), COUNT, &resource);
+        int afterBuild = resource.allocations;
+        EXPECT_EQ(afterBuild, COUNT);
+
+        PersistentSequence<int> changed = base.Set(COUNT / 3, -1);
+        PersistentSequence<int> appended = changed.Append(COUNT);
+        PersistentSequence<int> joined = appended.Concat(base);
+        EXPECT_LT(resource.allocations - afterBuild, 200);
+
+        EXPECT_EQ(base.Get(COUNT / 3), COUNT / 3);
+        EXPECT_EQ(changed.Get(COUNT / 3), -1);
+        EXPECT_EQ(joined.GetLength(), 2 * COUNT + 1);
+        EXPECT_EQ(joined.Get(COUNT), COUNT);
+        EXPECT_EQ(joined.Get(COUNT + 1 + COUNT / 3), COUNT / 3);
+        EXPECT_EQ(joined.GetResource(), &resource);
+
+        PersistentSequence<int> copy = base;
+        EXPECT_TRUE(copy.SharesRootWith(base));
+    }
+    EXPECT_EQ(resource.bytesInUse, 0);
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+TEST(MemoryResourceTest, PipelineAllocatesOnlyResult)
+{
+    // Проверяет: Конвейер не создаёт промежуточных контейнеров: без фильтров
+    // из источника памяти берётся один заранее зарезервированный буфер,
+    // после Where результат не резервирует длину всего источника
+    const int COUNT = 10000;
+    MutableArraySequence<int> source(COUNT);
+    for (int i = 0; i < COUNT; i++)
+    {
+        source.Set(i, i);
+    }
+    CountingResource resource;
+    {
+        MutableArraySequence<int> result = From(source)
+            .Map([](int value) { return value * value; })
+            .Skip(10)
+            .ToArraySequence(&resource);
+        EXPECT_EQ(result.GetLength(), COUNT - 10);
+        EXPECT_EQ(result.GetLast(), (COUNT - 1) * (COUNT - 1));
+        EXPECT_EQ(resource.allocations, 1);
+    }
+    EXPECT_EQ(resource.bytesInUse, 0);
+    {
+        CountingResource filtered;
+        MutableArraySequence<int> result = From(source)
+            .Map([](int value) { return value * value; })
+            .Where([](int value) { return value % 100 == 0; })
+            .ToArraySequence(&filtered);
+        EXPECT_EQ(result.GetLength(), COUNT / 10);
+        EXPECT_EQ(result.GetLast(), (COUNT - 10) * (COUNT - 10));
+        EXPECT_LE(filtered.largestAllocation, static_cast<std::int64_t>(2 * result.GetLength() * sizeof(int)));
+    }
+}
+
+// 11. Тесты параллельных алгоритмов
+
+TEST(ParallelAlgorithmsTest, MapReduceScanMatchSequential)
+{
+    // Проверяет: Параллельные map, reduce и scan совпадают с последовательными
+    // для массива и списка, а reduce не зависит от числа потоков
+    const int COUNT = 300000;
+    std::vector<double> data(COUNT);
+    for (int i = 0; i < COUNT; i++)
+    {
+        data[i] = 1.0 / (i + 1);
+    }
+    MutableArraySequence<double> array(data.data(), COUNT);
+    MutableListSequence<double> list(data.data(), 20000);
+
+    MutableArraySequence<double> squares = ParallelMap(static_cast<const Sequence<double>*>(&array), [](double value) { return value * value; });
+    ASSERT_EQ(squares.GetLength(), COUNT);
+    for (int i = 0; i < COUNT; i += 997)
+    {
+        EXPECT_EQ(squares.Get(i), data[i] * data[i]);
+    }
+
+    ThreadPool single(1);
+    ThreadPool several(4);
+    double sumSingle = ParallelReduce(static_cast<const Sequence<double>*>(&array), 0.0, std::plus<double>(), single);
+    double sumSeveral = ParallelReduce(static_cast<const Sequence<double>*>(&array), 0.0, std::plus<double>(), several);
+    EXPECT_EQ(sumSingle, sumSeveral);
+    EXPECT_NEAR(sumSingle, std::log(static_cast<double>(COUNT)) + 0.5772, 1e-3);
+
+    MutableArraySequence<double> prefix = ParallelInclusiveScan(static_cast<const Sequence<double>*>(&list), std::plus<double>(), several);
+    double running = 0;
+    for (int i = 0; i < 20000; i++)
+    {
+        running += data[i];
+        ASSERT_NEAR(prefix.Get(i), running, 1e-9);
+    }
+
+    MutableArraySequence<int> empty;
+    EXPECT_EQ(ParallelReduce(static_cast<const Sequence<int>*>(&empty), 7), 7);
+    EXPECT_EQ(ParallelInclusiveScan(static_cast<const Sequence<int>*>(&empty)).GetLength(), 0);
+}
+
+TEST(ParallelAlgorithmsTest, ParallelSortIsStable)
+{
+    // Проверяет: Параллельная сортировка упорядочивает массив и сохраняет
+    // порядок равных элементов
+    const int COUNT = 200000;
+    MutableArraySequence<std::pair<int, int>> sequence;
+    std::vector<std::pair<int, int>> reference;
+    unsigned seed = 3;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        std::pair<int, int> item(static_cast<int>((seed >> 16) % 1000), i);
+        sequence.Append(item);
+        reference.push_back(item);
+    }
+    auto byKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    ParallelSort(sequence, byKey);
+    std::stable_sort(reference.begin(), reference.end(), byKey);
+    for (int i = 0; i < COUNT; i++)
+    {
+        ASSERT_EQ(sequence.Get(i), reference[i]);
+    }
+}
+
+TEST(ParallelAlgorithmsTest, ThreadPoolNestingAndErrors)
+{
+    // Проверяет: Вложенные ParallelFor не блокируются, исключение из блока
+    // передаётся вызывающему
+    ThreadPool pool(4);
+    std::atomic<long long> total(0);
+    pool.ParallelFor(16, 1, [&pool, &total](std::int64_t begin, std::int64_t end)
+    {
+        for (std::int64_t i = begin; i < end; i++)
+        {
+            pool.ParallelFor(1000, 10, [&total](std::int64_t innerBegin, std::int64_t innerEnd)
+            {
+                total += innerEnd - innerBegin;
+            });
+        }
+    });
+    EXPECT_EQ(total.load(), 16000);
+    EXPECT_THROW(pool.ParallelFor(100, 1, [](std::int64_t begin, std::int64_t)
+    {
+        if (begin == 42) throw std::runtime_error("ошибка блока");
+    }), std::runtime_error);
+    EXPECT_EQ(pool.GetThreadCount(), 4);
+}
+
+TEST(ParallelAlgorithmsTest, ParallelHistogramMatchesSequential)
+{
+    // Проверяет: Параллельный подсчёт гистограммы большого массива совпадает
+    // с последовательным подсчётом того же набора в списке
+    const int COUNT = 200000;
+    std::vector<int> data(COUNT);
+    for (int i = 0; i < COUNT; i++)
+    {
+        data[i] = (i * 37) % 1000;
+    }
+    MutableArraySequence<int> array(data.data(), COUNT);
+    MutableListSequence<int> list(data.data(), COUNT);
+
+    // Рабочая таблица параллельного подсчёта — строка на поток, а не на блок
+    CountingResource resource;
+    Histogram<int> parallel(&resource);
+    parallel.CreateUniformRanges(0, 1000, 1000);
+    parallel.BuildHistogram(&array);
+    std::int64_t stripeTable = ThreadPool::Shared().GetThreadCount() * 1000 * static_cast<std::int64_t>(sizeof(std::int64_t));
+    EXPECT_LE(resource.largestAllocation, std::max<std::int64_t>(stripeTable, 1 << 16));
+    Histogram<int> sequential;
+    sequential.CreateUniformRanges(0, 1000, 1000);
+    sequential.BuildHistogram(&list);
+
+    EXPECT_EQ(parallel.GetTotalCount(), sequential.GetTotalCount());
+    auto keys = sequential.GetCounts().GetKeys();
+    for (std::int64_t i = 0; i < keys->GetLength(); i++)
+    {
+        SmallString key = keys->Get(i);
+        EXPECT_EQ(parallel.GetCounts().Get(key), sequential.GetCounts().Get(key));
+    }
+    delete keys;
+}
+
+// 12. Тесты сортировок
+
+TEST(SortingTest, IntroSortAndMergeSortMatchStd)
+{
+    // Проверяет: Сортировки совпадают с std::sort и std::stable_sort на
+    // случайных, упорядоченных, обратных и почти одинаковых данных
+    const int COUNT = 50000;
+    std::vector<std::vector<std::pair<int, int>>> inputs(4);
+    unsigned seed = 11;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        inputs[0].push_back(std::make_pair(static_cast<int>((seed >> 8) % 100000), i));
+        inputs[1].push_back(std::make_pair(i, i));
+        inputs[2].push_back(std::make_pair(COUNT - i, i));
+        inputs[3].push_back(std::make_pair(static_cast<int>((seed >> 16) % 3), i));
+    }
+    auto byKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    for (const std::vector<std::pair<int, int>>& input : inputs)
+    {
+        MutableArraySequence<std::pair<int, int>> unstable(input.data(), COUNT);
+        Sort(unstable);
+        std::vector<std::pair<int, int>> expected = input;
+        std::sort(expected.begin(), expected.end());
+        for (int i = 0; i < COUNT; i++)
+        {
+            ASSERT_EQ(unstable.Get(i), expected[i]);
+        }
+
+        MutableArraySequence<std::pair<int, int>> stable(input.data(), COUNT);
+        StableSort(stable, byKey);
+        expected = input;
+        std::stable_sort(expected.begin(), expected.end(), byKey);
+        for (int i = 0; i < COUNT; i++)
+        {
+            ASSERT_EQ(stable.Get(i), expected[i]);
+        }
+    }
+
+    MutableArraySequence<int> empty;
+    Sort(empty);
+    StableSort(empty);
+    EXPECT_EQ(empty.GetLength(), 0);
+}
+
+TEST(SortingTest, ListSortIsStable)
+{
+    // Проверяет: Список сортируется перестановкой узлов устойчиво,
+    // после сортировки корректны первый и последний элементы и добавление в конец
+    const int COUNT = 10000;
+    std::vector<std::pair<int, int>> reference;
+    MutableListSequence<std::pair<int, int>> list;
+    for (int i = 0; i < COUNT; i++)
+    {
+        std::pair<int, int> item((i * 7919) % 97, i);
+        list.Append(item);
+        reference.push_back(item);
+    }
+    auto byKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    StableSort(list, byKey);
+    std::stable_sort(reference.begin(), reference.end(), byKey);
+    std::int64_t index = 0;
+    list.ForEachChunk([&reference, &index](const std::pair<int, int>* items, std::int64_t count)
+    {
+        for (std::int64_t i = 0; i < count; i++, index++)
+        {
+            ASSERT_EQ(items[i], reference[index]);
+        }
+    });
+    EXPECT_EQ(index, COUNT);
+    EXPECT_EQ(list.GetFirst(), reference.front());
+    EXPECT_EQ(list.GetLast(), reference.back());
+    list.Append(std::make_pair(1000, -1));
+    EXPECT_EQ(list.GetLast(), std::make_pair(1000, -1));
+    EXPECT_EQ(list.GetLength(), COUNT + 1);
+
+    // Список с пропусками сортируется через буфер и остаётся индексируемым
+    MutableListSequence<std::pair<int, int>, IndexedSkipList<std::pair<int, int>>> skipList;
+    for (int i = 0; i < COUNT; i++)
+    {
+        skipList.Append(std::make_pair((i * 7919) % 97, i));
+    }
+    StableSort(skipList, byKey);
+    for (int i = 0; i < COUNT; i += 97)
+    {
+        ASSERT_EQ(skipList.Get(i), reference[i]);
+    }
+    EXPECT_EQ(skipList.GetLast(), reference.back());
+}
+
+TEST(SortingTest, RadixPartialAndNth)
+{
+    // Проверяет: Поразрядная сортировка знаковых ключей устойчива,
+    // PartialSort упорядочивает первые k, NthElement ставит k-й элемент на место
+    const int COUNT = 30000;
+    std::vector<std::pair<long long, int>> input;
+    unsigned seed = 5;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        long long key = static_cast<long long>(seed % 2001) - 1000;
+        input.push_back(std::make_pair(key * 1000003LL, i));
+    }
+    MutableArraySequence<std::pair<long long, int>> radix(input.data(), COUNT);
+    RadixSort(radix, [](const std::pair<long long, int>& item) { return item.first; });
+    std::vector<std::pair<long long, int>> expected = input;
+    std::stable_sort(expected.begin(), expected.end(), [](const std::pair<long long, int>& a, const std::pair<long long, int>& b)
+    {
+        return a.first < b.first;
+    });
+    for (int i = 0; i < COUNT; i++)
+    {
+        ASSERT_EQ(radix.Get(i), expected[i]);
+    }
+
+    std::vector<std::pair<long long, int>> sorted = input;
+    std::sort(sorted.begin(), sorted.end());
+    MutableArraySequence<std::pair<long long, int>> partial(input.data(), COUNT);
+    PartialSort(partial, 100);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(partial.Get(i), sorted[i]);
+    }
+    EXPECT_THROW(PartialSort(partial, -1), std::invalid_argument);
+
+    for (std::int64_t nth : {std::int64_t(0), std::int64_t(COUNT / 2), std::int64_t(COUNT - 1)})
+    {
+        MutableArraySequence<std::pair<long long, int>> selected(input.data(), COUNT);
+        NthElement(selected, nth);
+        ASSERT_EQ(selected.Get(nth), sorted[nth]);
+        for (std::int64_t i = 0; i < COUNT; i++)
+        {
+            ASSERT_EQ(i < nth ? !(sorted[nth] < selected.Get(i)) : !(selected.Get(i) < sorted[nth]), true);
+        }
+    }
+    EXPECT_THROW(NthElement(partial, COUNT), std::out_of_range);
+}
+
+TEST(SortingTest, TopKeywordsAndTasksKeepOrder)
+{
+    // Проверяет: Верхние ключевые слова идут по убыванию приоритета, при
+    // равенстве — по ключу; задачи с равным приоритетом сохраняют порядок
+    // и в массиве, и в списке
+    auto incidents = new MutableArraySequence<Incident>();
+    incidents->Append(Incident("beta", 5));
+    incidents->Append(Incident("gamma", 9));
+    incidents->Append(Incident("alpha", 5));
+    incidents->Append(Incident("delta", 1));
+
+    TaskPrioritizer prioritizer;
+    prioritizer.CalculateKeywordPriorities(incidents);
+    MutableArraySequence<SmallString> top = prioritizer.GetTopKeywords(3);
+    ASSERT_EQ(top.GetLength(), 3);
+    EXPECT_EQ(top.Get(0), SmallString("gamma"));
+    EXPECT_EQ(top.Get(1), SmallString("alpha"));
+    EXPECT_EQ(top.Get(2), SmallString("beta"));
+    EXPECT_EQ(prioritizer.GetTopKeywords(10).GetLength(), 4);
+
+    const char* names[] = {"first", "second", "third", "fourth", "fifth"};
+    const char* keywords[] = {"delta", "beta", "gamma", "alpha", "delta"};
+    auto arrayTasks = new MutableArraySequence<Task>();
+    auto listTasks = new MutableListSequence<Task>();
+    auto skipListTasks = new MutableListSequence<Task, IndexedSkipList<Task>>();
+    for (int i = 0; i < 5; i++)
+    {
+        arrayTasks->Append(Task(names[i], keywords[i]));
+        listTasks->Append(Task(names[i], keywords[i]));
+        skipListTasks->Append(Task(names[i], keywords[i]));
+    }
+    prioritizer.PrioritizeTasks(arrayTasks);
+    prioritizer.PrioritizeTasks(listTasks);
+    prioritizer.PrioritizeTasks(skipListTasks);
+    const char* expected[] = {"third", "second", "fourth", "first", "fifth"};
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(arrayTasks->Get(i).name, SmallString(expected[i]));
+        EXPECT_EQ(listTasks->Get(i).name, SmallString(expected[i]));
+        EXPECT_EQ(skipListTasks->Get(i).name, SmallString(expected[i]));
+    }
+
+    delete incidents;
+    delete arrayTasks;
+    delete listTasks;
+    delete skipListTasks;
+}
+
+// Замер: сортировка миллиона подстрок занимает заметно меньше секунды.
+// Запуск: --gtest_also_run_disabled_tests --gtest_filter=*MillionSubstrings*
+TEST(SortingTest, DISABLED_MillionSubstrings)
+{
+    const int COUNT = 1000000;
+    DynamicArray<SmallString> items;
+    items.Reserve(COUNT);
+    unsigned seed = 17;
+    char buffer[8];
+    for (int i = 0; i < COUNT; i++)
+    {
+        for (int j = 0; j < 6; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            buffer[j] = static_cast<char>('a' + (seed >> 16) % 26);
+        }
+        items.PushBack(SmallString(buffer, 1 + i % 6));
+    }
+    MutableArraySequence<SmallString> sequence(std::move(items));
+    auto start = std::chrono::steady_clock::now();
+    Sort(sequence);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << COUNT << " подстрок: " << elapsed.count() << " мс" << std::endl;
+    for (std::int64_t i = 1; i < COUNT; i++)
+    {
+        ASSERT_FALSE(sequence.Get(i) < sequence.Get(i - 1));
+    }
+    EXPECT_LT(elapsed.count(), 1000.0);
+}
+
+int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();